@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2012 Dan Eicher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file COPYING;
+ * if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * The calls of the overhead group of vgbench.py made straight from C, on
+ * the same kind of headless context, so `vgbench.py --native' can tell
+ * the cost of the binding from that of OpenVG.  Prints {name: ns/call}
+ * as JSON, the best of `repeat' batches of at least `min_time' seconds.
+ *
+ *     make -C benchmarks
+ *     benchmarks/native [min_time [repeat]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <GL/osmesa.h>
+#include "openvg.h"
+
+#define SIZE 256
+
+static VGPath path;
+static VGPaint paint;
+static volatile VGfloat sink;     /* keeps the results used */
+
+static double
+now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void get_error(long count) { while (count--) vgGetError(); }
+static void load_identity(long count) { while (count--) vgLoadIdentity(); }
+static void translate(long count) { while (count--) vgTranslate(0.0f, 0.0f); }
+static void scale(long count) { while (count--) vgScale(1.0f, 1.0f); }
+static void shear(long count) { while (count--) vgShear(0.0f, 0.0f); }
+static void rotate(long count) { while (count--) vgRotate(0.0f); }
+
+static void
+context_getitem(long count)
+{
+    while (count--)
+        sink += vgGetf(VG_STROKE_LINE_WIDTH);
+}
+
+static void
+context_setitem(long count)
+{
+    while (count--)
+        vgSetf(VG_STROKE_LINE_WIDTH, 1.0f);
+}
+
+static void
+context_paint_fill(long count)
+{
+    while (count--)
+        vgSetPaint(paint, VG_FILL_PATH);
+}
+
+static void
+clear(long count)
+{
+    while (count--)
+        vgClear(0, 0, 1, 1);
+}
+
+static void
+path_bounds(long count)
+{
+    VGfloat bounds[4];
+
+    while (count--) {
+        vgPathBounds(path, bounds, bounds + 1, bounds + 2, bounds + 3);
+        sink += bounds[0];
+    }
+}
+
+static void
+path_point_along_path(long count)
+{
+    VGfloat point[4];
+
+    while (count--) {
+        vgPointAlongPath(path, 0, 1, 0.0f, point, point + 1, point + 2, point + 3);
+        sink += point[0];
+    }
+}
+
+static const struct {
+    const char *name;
+    void (*func)(long count);
+} cases[] = {
+    {"overhead.get_error", get_error},
+    {"overhead.load_identity", load_identity},
+    {"overhead.translate", translate},
+    {"overhead.scale", scale},
+    {"overhead.shear", shear},
+    {"overhead.rotate", rotate},
+    {"overhead.context_getitem", context_getitem},
+    {"overhead.context_setitem", context_setitem},
+    {"overhead.context_paint_fill", context_paint_fill},
+    {"overhead.clear", clear},
+    {"overhead.path_bounds", path_bounds},
+    {"overhead.path_point_along_path", path_point_along_path},
+};
+
+/* the 16 segment zigzag of vgbench.py's line_path_data() */
+static void
+create_path(void)
+{
+    VGubyte segments[16];
+    VGfloat coords[30];
+    int idx;
+
+    path = vgCreatePath(VG_PATH_FORMAT_STANDARD, VG_PATH_DATATYPE_F, 1.0f, 0.0f,
+                        0, 0, VG_PATH_CAPABILITY_ALL);
+
+    segments[0] = VG_MOVE_TO_ABS;
+    for (idx = 1; idx < 15; idx++)
+        segments[idx] = VG_LINE_TO_ABS;
+    segments[15] = VG_CLOSE_PATH;
+
+    for (idx = 0; idx < 15; idx++) {
+        coords[idx * 2] = (VGfloat)(idx * SIZE) / 16;
+        coords[idx * 2 + 1] = idx % 2 ? SIZE : 0;
+    }
+
+    vgAppendPathData(path, 16, segments, coords);
+}
+
+int
+main(int argc, char **argv)
+{
+    double min_time = argc > 1 ? atof(argv[1]) : 0.05;
+    int repeat = argc > 2 ? atoi(argv[2]) : 5;
+    static unsigned char pixels[SIZE * SIZE * 4];
+    OSMesaContext context;
+    size_t idx;
+
+    context = OSMesaCreateContextExt(OSMESA_RGBA, 0, 8, 0, NULL);
+    if (context == NULL ||
+        !OSMesaMakeCurrent(context, pixels, GL_UNSIGNED_BYTE, SIZE, SIZE) ||
+        !vgCreateContextSH(SIZE, SIZE)) {
+        fprintf(stderr, "Unable to create a headless OpenVG context\n");
+        return 1;
+    }
+    create_path();
+    paint = vgCreatePaint();
+
+    printf("{");
+    for (idx = 0; idx < sizeof(cases) / sizeof(cases[0]); idx++) {
+        long count = 1;
+        double elapsed, best = 0.0;
+        int run;
+
+        while (true) {
+            double start = now();
+
+            cases[idx].func(count);
+            elapsed = now() - start;
+            if (elapsed >= min_time)
+                break;
+            count = elapsed > 0.0 ? (long)(count * min_time * 1.2 / elapsed) + 1 : count * 10;
+        }
+
+        for (run = 0; run < repeat; run++) {
+            double start = now();
+
+            cases[idx].func(count);
+            elapsed = now() - start;
+            if (run == 0 || elapsed < best)
+                best = elapsed;
+        }
+
+        printf("%s\n \"%s\": %.3f", idx ? "," : "", cases[idx].name,
+               best * 1e9 / count);
+    }
+    printf("\n}\n");
+
+    vgDestroyPaint(paint);
+    vgDestroyPath(path);
+    vgDestroyContextSH();
+    OSMesaDestroyContext(context);
+    return 0;
+}
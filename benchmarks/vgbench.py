@@ -0,0 +1,418 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2012 Dan Eicher
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library in the file COPYING;
+# if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+#
+
+"""
+Benchmarks of the OpenVG bindings, run on a headless context (an
+OPENVG_HEADLESS=1 build, rendering with OSMesa on the CPU).
+
+    make -C benchmarks          # only for --native
+    python benchmarks/vgbench.py [-o results.json] [-k filter]
+                                 [--native benchmarks/native]
+                                 [--compare baseline.json]
+
+Each case is timed in batches of calls long enough to last --min-time
+seconds, the batch is repeated --repeat times and the best and median
+nanoseconds per call are reported.  Batches that render end with
+vgFinish so the work is included.  The results are written as JSON;
+--compare checks them against an earlier file and exits with 1 if a case
+got slower than --threshold or is missing.  A case that raises is listed
+under "failed" and also makes the run exit with 1.  --native runs the
+program the Makefile builds from native.cc, which makes the calls of the
+overhead group straight from C, and adds its native_ns and the
+binding_ns left to the binding to them.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import platform
+import subprocess
+import sys
+import time
+from array import array
+
+from OpenVG import VG, VGU
+
+try:
+    xrange
+except NameError:
+    xrange = range
+
+clock = getattr(time, 'perf_counter', time.time)
+
+SIZE = 256
+
+PATH_SEGMENTS = (16, 256, 4096)
+FILTER_SIZE = 256
+IMAGE_FORMATS = ('VG_sRGBX_8888', 'VG_sRGBA_8888', 'VG_sRGBA_8888_PRE',
+                 'VG_sRGB_565', 'VG_sRGBA_5551', 'VG_sRGBA_4444',
+                 'VG_sL_8', 'VG_lRGBX_8888', 'VG_lRGBA_8888',
+                 'VG_lRGBA_8888_PRE', 'VG_lL_8', 'VG_A_8', 'VG_BW_1',
+                 'VG_sXRGB_8888', 'VG_sARGB_8888', 'VG_sARGB_8888_PRE',
+                 'VG_sBGRX_8888', 'VG_sBGRA_8888', 'VG_sBGRA_8888_PRE',
+                 'VG_sXBGR_8888', 'VG_sABGR_8888', 'VG_sABGR_8888_PRE')
+
+
+class Bench(object):
+    def __init__(self, context, min_time, repeat, pattern):
+        self.context = context
+        self.min_time = min_time
+        self.repeat = repeat
+        self.pattern = pattern
+        self.results = []
+        self.failed = []
+
+    def wanted(self, name):
+        return self.pattern is None or self.pattern in name
+
+    def batch(self, func, count):
+        start = clock()
+        func(count)
+        return clock() - start
+
+    def measure(self, func):
+        """Nanoseconds per call of func(count), which makes `count' calls."""
+        count = 1
+        while True:
+            elapsed = self.batch(func, count)
+            if elapsed >= self.min_time or count >= 1 << 30:
+                break
+            if elapsed <= 0.0:
+                count *= 10
+            else:
+                count = max(count + 1, int(count * self.min_time * 1.2 / elapsed))
+
+        times = sorted(self.batch(func, count) * 1e9 / count
+                       for _ in xrange(self.repeat))
+        return count, times[0], times[len(times) // 2]
+
+    def run(self, group, name, func, params=None, unit=None, amount=None):
+        """Time `func'; `amount' of `unit' per call gives a throughput."""
+        name = '%s.%s' % (group, name)
+        if not self.wanted(name):
+            return
+
+        try:
+            count, best, median = self.measure(func)
+        except Exception as error:
+            print('%-48s failed: %s' % (name, error), file=sys.stderr)
+            self.failed.append({'name': name, 'error': str(error)})
+            VG.get_error()
+            return
+
+        result = {'name': name,
+                  'group': group,
+                  'params': params or {},
+                  'calls': count,
+                  'repeat': self.repeat,
+                  'best_ns': best,
+                  'median_ns': median}
+        if unit is not None:
+            result['unit'] = unit
+            result['throughput'] = amount * 1e9 / best
+        self.results.append(result)
+
+        line = '%-48s %12.1f ns/call' % (name, best)
+        if unit is not None:
+            line += '  %12.4g %s/s' % (result['throughput'], unit)
+        print(line, file=sys.stderr)
+
+
+def loop(call, *args):
+    def func(count):
+        for _ in xrange(count):
+            call(*args)
+    return func
+
+
+def rendering(context, call, *args):
+    def func(count):
+        for _ in xrange(count):
+            call(*args)
+        context.finish()
+    return func
+
+
+def line_path_data(segments):
+    """A closed zigzag of `segments' segments across the surface."""
+    commands = array('B', [VG.VGPathCommand.VG_MOVE_TO_ABS])
+    commands.extend([VG.VGPathCommand.VG_LINE_TO_ABS] * (segments - 2))
+    commands.append(VG.VGPathSegment.VG_CLOSE_PATH)
+    coords = array('f')
+    for idx in xrange(segments - 1):
+        coords.append(float(idx * SIZE) / segments)
+        coords.append(float(SIZE if idx % 2 else 0))
+    return commands, coords
+
+
+def new_path():
+    return VG.VGPath(0, VG.VGPathDatatype.VG_PATH_DATATYPE_F, 1.0, 0.0, 0, 0,
+                     VG.VGPathCapabilities.VG_PATH_CAPABILITY_ALL)
+
+
+def bench_paths(bench):
+    for segments in PATH_SEGMENTS:
+        commands, coords = line_path_data(segments)
+        path = new_path()
+
+        def append(count, path=path, commands=commands, coords=coords):
+            for _ in xrange(count):
+                path.clear()
+                path.append_data(len(commands), commands, coords)
+
+        bench.run('path', 'append_data[%d]' % segments, append,
+                  {'segments': segments}, 'segments', segments)
+
+        points = [float(value) for value in coords]
+
+        def polygon(count, path=path, points=points):
+            for _ in xrange(count):
+                path.clear()
+                VGU.polygon(path, points, True)
+
+        bench.run('path', 'vgu_polygon[%d]' % segments, polygon,
+                  {'segments': segments}, 'segments', segments)
+
+    for segments in PATH_SEGMENTS:
+        commands, coords = line_path_data(segments)
+        path = new_path()
+        path.append_data(len(commands), commands, coords)
+        bench.run('path', 'draw[%d]' % segments,
+                  rendering(bench.context, path.draw),
+                  {'segments': segments}, 'segments', segments)
+
+
+def format_bits(name):
+    """Bits per pixel, from the digits of the format name."""
+    for part in name.split('_')[2:]:
+        if part.isdigit():
+            return sum(int(digit) for digit in part)
+    raise ValueError(name)
+
+
+def bench_images(bench):
+    quality = VG.VGImageQuality.VG_IMAGE_QUALITY_FASTER
+
+    for name in IMAGE_FORMATS:
+        format = getattr(VG.VGImageFormat, name, None)
+        if format is None:
+            continue
+
+        stride = (SIZE * format_bits(name) + 7) // 8
+        data = bytearray(stride * SIZE)
+        params = {'format': name, 'width': SIZE, 'height': SIZE}
+        try:
+            image = VG.VGImage(format, SIZE, SIZE, quality)
+        except Exception as error:
+            print('image.%-42s skipped: %s' % (name, error), file=sys.stderr)
+            VG.get_error()
+            continue
+
+        bench.run('image', 'set_sub_data[%s]' % name,
+                  rendering(bench.context, image.set_sub_data, data, stride,
+                            format, 0, 0, SIZE, SIZE),
+                  params, 'bytes', len(data))
+        bench.run('image', 'get_sub_data_into[%s]' % name,
+                  loop(image.get_sub_data_into, data, stride, format,
+                       0, 0, SIZE, SIZE),
+                  params, 'bytes', len(data))
+
+
+def bench_filters(bench):
+    format = VG.VGImageFormat.VG_sRGBA_8888
+    quality = VG.VGImageQuality.VG_IMAGE_QUALITY_FASTER
+    tiling = VG.VGTilingMode.VG_TILE_PAD
+    size = FILTER_SIZE
+    pixels = size * size
+    params = {'width': size, 'height': size}
+
+    src = VG.VGImage(format, size, size, quality)
+    dst = VG.VGImage(format, size, size, quality)
+    src.set_sub_data(bytearray(range(256)) * (pixels * 4 // 256), size * 4,
+                     format, 0, 0, size, size)
+
+    def run(name, call, *args):
+        bench.run('filter', name, rendering(bench.context, call, *args),
+                  params, 'pixels', pixels)
+
+    for kernel in (3, 7):
+        run('convolve[%dx%d]' % (kernel, kernel), dst.convolve, src,
+            kernel, kernel, kernel // 2, kernel // 2, [1] * (kernel * kernel),
+            1.0 / (kernel * kernel), 0.0, tiling)
+        run('separable_convolve[%dx%d]' % (kernel, kernel),
+            dst.separable_convolve, src, kernel, kernel, kernel // 2,
+            kernel // 2, [1] * kernel, [1] * kernel,
+            1.0 / (kernel * kernel), 0.0, tiling)
+
+    for deviation in (1.0, 4.0):
+        run('gaussian_blur[%g]' % deviation, dst.gaussian_blur, src,
+            deviation, deviation, tiling)
+
+    matrix = [0.0] * 20
+    for idx in range(4):
+        matrix[idx * 5] = 1.0
+    run('color_matrix', dst.color_matrix, src, matrix)
+
+    table = bytearray(255 - value for value in range(256))
+    run('lookup', dst.lookup, src, table, table, table, table, False, False)
+    run('lookup_single', dst.lookup_single, src, list(range(256)),
+        VG.VGImageChannel.VG_RED, False, False)
+
+
+def bench_overhead(bench):
+    """Cost of the cheapest calls, mostly argument parsing and checks."""
+    context = bench.context
+    path = new_path()
+    commands, coords = line_path_data(16)
+    path.append_data(len(commands), commands, coords)
+    key = VG.VGParamType.VG_STROKE_LINE_WIDTH
+    paint = VG.VGPaint()
+
+    def empty(count):
+        for _ in xrange(count):
+            pass
+
+    def get_param(count):
+        for _ in xrange(count):
+            context[key]
+
+    def set_param(count):
+        for _ in xrange(count):
+            context[key] = 1.0
+
+    def set_paint(count):
+        for _ in xrange(count):
+            context.paint_fill = paint
+
+    cases = (('loop', empty),
+             ('get_error', loop(VG.get_error)),
+             ('load_identity', loop(context.load_identity)),
+             ('translate', loop(context.translate, 0.0, 0.0)),
+             ('scale', loop(context.scale, 1.0, 1.0)),
+             ('shear', loop(context.shear, 0.0, 0.0)),
+             ('rotate', loop(context.rotate, 0.0)),
+             ('context_getitem', get_param),
+             ('context_setitem', set_param),
+             ('context_paint_fill', set_paint),
+             ('clear', loop(context.clear, 0, 0, 1, 1)),
+             ('path_bounds', loop(path.bounds)),
+             ('path_point_along_path', loop(path.point_along_path, 0, 1, 0.0)))
+
+    for name, func in cases:
+        bench.run('overhead', name, func)
+
+
+def add_native(results, program, min_time, repeat):
+    output = subprocess.check_output([program, str(min_time), str(repeat)])
+    native = json.loads(output.decode('ascii'))
+
+    for result in results:
+        if result['name'] in native:
+            result['native_ns'] = native[result['name']]
+            result['binding_ns'] = result['best_ns'] - result['native_ns']
+            print('%-48s %12.1f ns/call native, %9.1f binding'
+                  % (result['name'], result['native_ns'],
+                     result['binding_ns']), file=sys.stderr)
+
+
+def compare(bench, filename, threshold):
+    """Number of cases slower than `threshold' or missing since `filename'."""
+    with open(filename) as stream:
+        baseline = dict((result['name'], result)
+                        for result in json.load(stream)['results'])
+
+    names = set(result['name'] for result in bench.results)
+    regressions = 0
+    for name in sorted(baseline):
+        if name not in names and bench.wanted(name):
+            regressions += 1
+            print('%-48s missing' % name, file=sys.stderr)
+
+    for result in bench.results:
+        previous = baseline.get(result['name'])
+        if previous is None:
+            continue
+        ratio = result['best_ns'] / previous['best_ns']
+        if ratio > 1.0 + threshold:
+            regressions += 1
+            print('%-48s %.2fx slower' % (result['name'], ratio),
+                  file=sys.stderr)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('-o', '--output', help='JSON file, default stdout')
+    parser.add_argument('-k', dest='pattern',
+                        help='only cases whose name contains PATTERN')
+    parser.add_argument('--min-time', type=float, default=0.05,
+                        help='seconds a timed batch lasts at least')
+    parser.add_argument('--repeat', type=int, default=5,
+                        help='timed batches per case')
+    parser.add_argument('--native', metavar='PROGRAM',
+                        help='native.cc program to compare the overhead with')
+    parser.add_argument('--compare', metavar='JSON',
+                        help='results of an earlier run to check against')
+    parser.add_argument('--threshold', type=float, default=0.10,
+                        help='slowdown --compare fails on (default 0.10)')
+    args = parser.parse_args()
+
+    context = VG.VGContext(SIZE, SIZE, headless=True)
+    VG.enable_stats(False)
+    VG.stop_trace()
+
+    bench = Bench(context, args.min_time, args.repeat, args.pattern)
+    bench_overhead(bench)
+    bench_paths(bench)
+    bench_images(bench)
+    bench_filters(bench)
+
+    if args.native:
+        add_native(bench.results, args.native, args.min_time, args.repeat)
+
+    output = {'meta': {'python': platform.python_version(),
+                       'platform': platform.platform(),
+                       'vendor': VG.get_string(VG.VGStringID.VG_VENDOR),
+                       'renderer': VG.get_string(VG.VGStringID.VG_RENDERER),
+                       'version': VG.get_string(VG.VGStringID.VG_VERSION),
+                       'surface': [SIZE, SIZE],
+                       'min_time': args.min_time,
+                       'repeat': args.repeat,
+                       'time': time.strftime('%Y-%m-%dT%H:%M:%S')},
+              'results': bench.results,
+              'failed': bench.failed}
+
+    if args.output:
+        with open(args.output, 'w') as stream:
+            json.dump(output, stream, indent=1, sort_keys=True)
+    else:
+        json.dump(output, sys.stdout, indent=1, sort_keys=True)
+        print()
+
+    if args.compare and compare(bench, args.compare, args.threshold):
+        return 1
+    if bench.failed:
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -91,6 +91,19 @@ typedef struct {
     VGPath obj;
     unsigned int paint_modes;
     unsigned int capabilities;
+    VGubyte *segments;          /* copy of the segment commands */
+    VGint num_segments;         /* -1 when the layout is unknown */
+    VGint max_segments;
+    VGPathDatatype datatype;
+    VGfloat scale, bias;
+    void *data;                 /* copy of the coordinates in `datatype' */
+    VGint num_coords;
+    VGint max_coords;
+    VGint coord_segments;       /* leading segments `coords' covers */
+    VGfloat flat_tolerance;     /* tessellation cache, 0 when disabled */
+    VGfloat flat_band;
+    VGPath flat;                /* flattened copy, or VG_INVALID_HANDLE */
+    VGfloat flat_scale[2];      /* scales `flat' is valid for */
 } PyVGPath;
 
 
@@ -104,19 +117,275 @@ typedef struct {
     VGImage obj;
 } PyVGImage;
 
+struct context_state;
+
 typedef struct {
     PyObject_HEAD
     bool init;
     int dimensions[2];
+    void *headless;             /* OSMesaContext of a headless surface */
+    unsigned char *surface;     /* RGBA pixels of a headless surface */
+    struct context_state *state;    /* saved while another context is current */
+    unsigned char *target;      /* headless render target bound instead */
+    int target_dimensions[2];
+    int targets;                /* VGRenderTargets entered */
 } PyVGContext;
 
+typedef struct {
+    PyObject_HEAD
+    struct display_command *commands;
+    Py_ssize_t num_commands;
+    Py_ssize_t max_commands;
+    union display_value *values;    /* matrices and parameter vectors */
+    Py_ssize_t num_values;
+    Py_ssize_t max_values;
+    PyObject *handles;              /* set of objects the commands use */
+    int executing;                  /* replays running without the GIL */
+} PyVGDisplayList;
+
+typedef struct {
+    PyObject_HEAD
+    PyVGContext *context;
+    PyVGImage *image;
+    VGint width, height;
+    bool active;
+    int depth;                      /* context->targets once entered */
+    unsigned char *pixels;          /* headless: surface drawn into */
+    unsigned char *previous;        /* headless: target bound before */
+    int previous_dimensions[2];
+    VGImage saved;                  /* GL: surface pixels drawn over */
+    VGint scissoring;
+    VGint *scissor_rects;
+    VGint num_scissor_rects;
+} PyVGRenderTarget;
+
+
+struct glyph_entry;
+
+typedef struct {
+    PyObject_HEAD
+    struct glyph_entry *entries;
+    Py_ssize_t num_entries;
+    Py_ssize_t max_entries;
+    Py_ssize_t free_entry;          /* first unused entry, or -1 */
+    Py_ssize_t *table;              /* entry index per slot */
+    Py_ssize_t table_size;
+    Py_ssize_t table_used;          /* slots not empty, deleted included */
+    Py_ssize_t head, tail;          /* most and least recently used */
+    Py_ssize_t count;
+    Py_ssize_t size;                /* bytes held */
+    Py_ssize_t budget;
+    int executing;                  /* runs drawing without the GIL */
+} PyVGGlyphCache;
+
 
 extern PyTypeObject PyVGPath_Type;
 extern PyTypeObject PyVGPaint_Type;
 extern PyTypeObject PyVGImage_Type;
 extern PyTypeObject PyVGContext_Type;
+extern PyTypeObject PyVGDisplayList_Type;
+extern PyTypeObject PyVGRenderTarget_Type;
+extern PyTypeObject PyVGGlyphCache_Type;
+
+/*
+ * ShivaVG is not thread-safe and the GIL only serializes the calls made
+ * while holding it.  Calls that release it hold backend_mutex until they
+ * are done, between VG_BEGIN_ALLOW_THREADS and VG_END_ALLOW_THREADS;
+ * every other backend call is made holding the GIL, after backend_wait()
+ * has let such a call finish.  Both wait with the GIL released.  None can
+ * start until the GIL is released again, so backend_wait() must directly
+ * precede the calls, with no Python code run in between.  Both also load
+ * the VGContext of the calling thread when another thread called last:
+ * its state into ShivaVG, and its GL context on this thread as GL keeps
+ * one per thread.
+ */
+extern PyThread_type_lock backend_mutex;
+extern int backend_busy;            /* calls without the GIL, under the GIL */
+extern unsigned long backend_thread;    /* thread the GL context is bound on */
+
+void backend_acquire(void);
+void backend_sync(void);
+void backend_bind_thread(void);
+
+static inline void
+backend_wait(void)
+{
+    if (backend_busy)
+        backend_sync();
+    if (backend_thread != PyThread_get_thread_ident())
+        backend_bind_thread();
+}
+
+/* pixels below which clearing keeps the GIL */
+#define BACKEND_RELEASE_PIXELS 4096
+
+#define VG_BEGIN_ALLOW_THREADS \
+    { \
+        backend_acquire(); \
+        Py_BEGIN_ALLOW_THREADS
+#define VG_END_ALLOW_THREADS \
+        PyThread_release_lock(backend_mutex); \
+        Py_END_ALLOW_THREADS \
+        backend_busy--; \
+        backend_wait(); \
+    }
 
 VGErrorCode check_error(void);
+VGErrorCode check_pending_error(bool always);
+bool get_errors_deferred(void);
+VGErrorCode set_errors_deferred(bool deferred);
+Py_ssize_t pixel_data_size(VGint stride, VGImageFormat format,
+                           VGint width, VGint height, Py_ssize_t *offset);
+
+void pixel_convert_init(void);
+bool pixel_convert_supported(VGImageFormat format);
+void pixel_convert(const void *src, VGint srcStride, VGImageFormat srcFormat,
+                   void *dst, VGint dstStride, VGImageFormat dstFormat,
+                   VGint width, VGint height);
+
+typedef struct {
+    void *data;             /* NULL when no conversion is needed */
+    VGint stride;
+    VGImageFormat format;
+} pixel_stage;
+
+int pixel_stage_init(pixel_stage *stage, VGImageFormat dataFormat,
+                     VGint transferFormat, VGint width, VGint height);
+void pixel_stage_pack(pixel_stage *stage, const void *data, VGint dataStride,
+                      VGImageFormat dataFormat, VGint width, VGint height);
+void pixel_stage_unpack(pixel_stage *stage, void *data, VGint dataStride,
+                        VGImageFormat dataFormat, VGint width, VGint height);
+void pixel_stage_free(pixel_stage *stage);
+
+void path_record_segments(PyVGPath *path, const VGubyte *segments, VGint count);
+void path_verify_segments(PyVGPath *path);
+void path_forget_segments(PyVGPath *path);
+bool path_forget_unchecked(PyVGPath *path);
+void path_record_data(PyVGPath *path, const void *data, VGint count,
+                      VGint segments);
+void path_release_coords(PyVGPath *path);
+bool path_coords_known(PyVGPath *path);
+int path_segment_coords(VGubyte segment);
+int path_datatype_size(VGPathDatatype type);
+void path_data_to_user(const void *data, VGPathDatatype type, VGfloat scale,
+                       VGfloat bias, VGfloat *out, Py_ssize_t count);
+bool path_user_to_data(const VGfloat *user, VGPathDatatype type, VGfloat scale,
+                       VGfloat bias, void *out, Py_ssize_t count);
+PyVGPath *path_create(VGPathDatatype datatype, VGfloat scale, VGfloat bias,
+                      VGint segmentCapacityHint, VGint coordCapacityHint,
+                      VGbitfield capabilities);
+
+VGPath path_flatten(PyVGPath *path, VGfloat tolerance);
+VGPath path_tessellation(PyVGPath *path);
+void path_invalidate_tessellation(PyVGPath *path);
+
+Py_ssize_t path_parse_svg(const char *d, Py_ssize_t length, VGubyte *segments,
+                          VGfloat *coords, VGint *num_segments, VGint *num_coords);
+
+void display_list_replay(PyVGDisplayList *list);
+
+PyVGContext *get_current_context(void);
+VGErrorCode context_take_error(void);
+int context_bind_target(PyVGContext *context, unsigned char *pixels,
+                        VGint width, VGint height);
+
+/*
+ * Argument parsing of the small, often called methods, in the manner of
+ * Argument Clinic.  On Python 3.7+ they are METH_FASTCALL and receive the
+ * arguments as an array with the keyword names in a tuple, so no argument
+ * tuple or keyword dict is built per call; older Pythons call the same
+ * functions through METH_VARARGS.  fast_unpack() fills `argv' in keyword
+ * order, NULL for optional arguments that were not given; the other
+ * fast_ functions convert them like the PyArg formats f, i, I and O!.
+ */
+struct fast_parser {
+    const char *name;               /* method name for messages */
+    const char *const *keywords;
+    int required;
+    int total;
+};
+
+#if PY_VERSION_HEX >= 0x03070000
+#define METH_FAST (METH_FASTCALL|METH_KEYWORDS)
+#define FAST_ARGS PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames
+#define FAST_PASS args, nargs, kwnames
+#else
+#define METH_FAST (METH_KEYWORDS|METH_VARARGS)
+#define FAST_ARGS PyObject *args, PyObject *kwargs
+#define FAST_PASS args, kwargs
+#endif
+
+bool fast_unpack(FAST_ARGS, const struct fast_parser *parser, PyObject **argv);
+bool fast_float(PyObject *value, VGfloat *out);
+bool fast_int(PyObject *value, VGint *out);
+bool fast_bitfield(PyObject *value, VGbitfield *out);
+bool fast_object(PyObject *value, PyTypeObject *type, void *out);
+PyObject *fast_float_tuple(const VGfloat *values, int count);
+
+/*
+ * Call statistics of VG.stats() and the tracer of VG.start_trace().  Each
+ * instrumented entry point has a static stats_entry and opens a
+ * stats_scope, which only reads the clock while either is enabled and
+ * records the call when it goes out of scope, as a failure if an
+ * exception is set by then.
+ */
+#define STATS_BUCKETS 256
+
+struct stats_entry {
+    const char *name;
+    struct stats_entry *next;       /* entries called so far */
+    bool listed;
+    unsigned long long calls;
+    unsigned long long errors;
+    unsigned long long bytes;
+    double seconds;
+    double max;
+    unsigned long long buckets[STATS_BUCKETS];  /* log-linear nanoseconds */
+};
+
+#define STATS_ENTRY(var, name) static struct stats_entry var = {name, NULL, false, 0, 0, 0, 0.0, 0.0, {0}}
+
+extern bool stats_enabled;
+extern bool trace_enabled;
+double stats_clock(void);
+void stats_record(struct stats_entry *entry, double start, Py_ssize_t bytes, bool failed);
+void trace_record(const char *name, double start, double end, VGHandle handle,
+                  Py_ssize_t bytes, bool failed);
+
+struct stats_scope {
+    struct stats_entry *entry;
+    double start;
+    Py_ssize_t bytes;               /* data marshalled by the call */
+    VGHandle handle;                /* OpenVG object the call works on */
+
+    stats_scope(struct stats_entry *entry)
+        : entry(entry), start(stats_enabled || trace_enabled ? stats_clock() : 0.0),
+          bytes(0), handle(VG_INVALID_HANDLE) {}
+    ~stats_scope() {
+        if (start != 0.0)
+            end();
+    }
+    void end(void);
+};
+
+extern const char OpenVG_SavePaths__doc__[];
+extern const char OpenVG_LoadPaths__doc__[];
+PyObject *OpenVG_SavePaths(PyObject *dummy, PyObject *args, PyObject *kwargs);
+PyObject *OpenVG_LoadPaths(PyObject *dummy, PyObject *args, PyObject *kwargs);
+
+extern const char OpenVG_Stats__doc__[];
+extern const char OpenVG_ResetStats__doc__[];
+extern const char OpenVG_EnableStats__doc__[];
+PyObject *OpenVG_Stats(PyObject *dummy);
+PyObject *OpenVG_ResetStats(PyObject *dummy);
+PyObject *OpenVG_EnableStats(PyObject *dummy, PyObject *args, PyObject *kwargs);
+
+extern const char OpenVG_StartTrace__doc__[];
+extern const char OpenVG_StopTrace__doc__[];
+extern const char OpenVG_DumpTrace__doc__[];
+PyObject *OpenVG_StartTrace(PyObject *dummy, PyObject *args, PyObject *kwargs);
+PyObject *OpenVG_StopTrace(PyObject *dummy);
+PyObject *OpenVG_DumpTrace(PyObject *dummy, PyObject *args, PyObject *kwargs);
 
 PyObject *initVG(void);
 PyObject *initVGU(void);
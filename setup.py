@@ -1,14 +1,38 @@
+import os
 from distutils.core import setup, Extension
 
+# OPENVG_HEADLESS=1 builds against OSMesa instead of libGL so that
+# VGContext(..., headless=True) renders on the CPU without a display.
+# ShivaVG must then be linked against OSMesa as well.  The switch is
+# build-wide: ShivaVG calls whichever GL it was linked with, so one build
+# can't offer both backends.
+if os.environ.get('OPENVG_HEADLESS'):
+    gl_libraries = ['OSMesa', 'GLU']
+    define_macros = [('HAVE_OSMESA', None)]
+else:
+    gl_libraries = ['GL', 'GLU']
+    define_macros = []
+
 module_openvg = Extension('OpenVG',
                           include_dirs = ['.', '/usr/include/vg'],
-                          libraries = ['OpenVG', 'GL', 'GLU'],
+                          libraries = ['OpenVG'] + gl_libraries,
                           library_dirs = ['/usr/lib'],
+                          define_macros = define_macros,
                           sources = ['vg_image.cc',
                                      'vg_path.cc',
+                                     'vg_flatten.cc',
+                                     'vg_svg.cc',
+                                     'vg_path_file.cc',
+                                     'vg_stats.cc',
+                                     'vg_trace.cc',
+                                     'vg_args.cc',
                                      'vg_context.cc',
                                      'vg_paint.cc',
+                                     'vg_display_list.cc',
+                                     'vg_render_target.cc',
+                                     'vg_glyph_cache.cc',
                                      'vg_module.cc',
+                                     'vg_convert.cc',
                                      'vgu_module.cc',
                                      'openvg_module.cc'])
 
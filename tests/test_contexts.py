@@ -0,0 +1,156 @@
+"""Two headless VGContexts drawn into from two threads at once.
+
+Needs a build made with OPENVG_HEADLESS=1; skipped otherwise.
+
+    python -m unittest discover tests
+"""
+
+import threading
+import unittest
+
+from OpenVG import VG, VGU
+
+SIZE = 32
+ROUNDS = 50
+FORMAT = VG.VGImageFormat.VG_sRGBA_8888
+CLEAR_COLOR = VG.VGParamType.VG_CLEAR_COLOR
+LINE_WIDTH = VG.VGParamType.VG_STROKE_LINE_WIDTH
+
+# per context: clear color, fill color, line width, rectangle
+SCENES = (
+    ([1.0, 0.0, 0.0, 1.0], 0x00ff00ff, 3.0, (4, 4, 12, 20)),
+    ([0.0, 0.0, 1.0, 1.0], 0xffff00ff, 7.0, (16, 8, 10, 6)),
+)
+
+
+def new_path():
+    return VG.VGPath(0, VG.VGPathDatatype.VG_PATH_DATATYPE_F, 1.0, 0.0, 0, 0,
+                     VG.VGPathCapabilities.VG_PATH_CAPABILITY_ALL)
+
+
+class Scene(object):
+    """What one thread sets and draws, and checks it still sees."""
+
+    def __init__(self, context, clear_color, fill_color, line_width, rect):
+        self.context = context
+        self.clear_color = clear_color
+        self.line_width = line_width
+        self.paint = VG.VGPaint()
+        self.paint.color = fill_color
+        self.path = new_path()
+        VGU.rect(self.path, *rect)
+        self.matrix = [1.0, 0.0, 0.0, 0.0, 1.0, 0.0, float(rect[0]), 0.0, 1.0]
+
+    def setup(self):
+        context = self.context
+        context[CLEAR_COLOR] = self.clear_color
+        context[LINE_WIDTH] = self.line_width
+        context.paint_fill = self.paint
+        context.load_matrix(self.matrix)
+
+    def draw(self):
+        self.context.clear(0, 0, SIZE, SIZE)
+        self.path.draw()
+
+    def state(self):
+        context = self.context
+        return (list(context[CLEAR_COLOR]), context[LINE_WIDTH],
+                context.get_matrix())
+
+    def pixels(self):
+        return self.context.read_pixels(SIZE * 4, FORMAT, 0, 0, SIZE, SIZE)
+
+
+class TwoThreads(unittest.TestCase):
+
+    def setUp(self):
+        try:
+            self.contexts = [VG.VGContext(SIZE, SIZE, headless=True)
+                             for scene in SCENES]
+        except RuntimeError as error:
+            self.skipTest(str(error))
+
+    def tearDown(self):
+        del self.contexts
+
+    def scenes(self):
+        return [Scene(context, *scene)
+                for context, scene in zip(self.contexts, SCENES)]
+
+    def expected(self, scenes):
+        """Each scene drawn on this thread, one context after the other."""
+        results = []
+        for scene in scenes:
+            with scene.context:
+                scene.setup()
+                scene.draw()
+                scene.context.finish()
+                results.append((scene.state(), scene.pixels()))
+        return results
+
+    def test_no_leaks(self):
+        scenes = self.scenes()
+        expected = self.expected(scenes)
+        self.assertNotEqual(expected[0][1], expected[1][1])
+
+        barrier = threading.Barrier(len(scenes), timeout=30)
+        results = [None] * len(scenes)
+        failures = []
+
+        def run(index):
+            scene = scenes[index]
+            try:
+                with scene.context:
+                    scene.setup()
+                    # both threads are inside `with' at once and take
+                    # turns call by call
+                    for _ in range(ROUNDS):
+                        barrier.wait()
+                        scene.draw()
+                        state = scene.state()
+                        if state != expected[index][0]:
+                            failures.append((index, state))
+                    scene.context.finish()
+                    results[index] = (scene.state(), scene.pixels())
+            except Exception as error:
+                failures.append((index, error))
+                barrier.abort()
+
+        threads = [threading.Thread(target=run, args=(index,))
+                   for index in range(len(scenes))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertEqual(failures, [])
+        for index, result in enumerate(results):
+            self.assertEqual(result[0], expected[index][0])
+            self.assertEqual(result[1], expected[index][1],
+                             "pixels of context %d changed" % index)
+
+    def test_outside_with(self):
+        """A thread outside `with' draws into the first context."""
+        first, second = self.scenes()
+        with second.context:
+            second.setup()
+        first.setup()
+
+        def run():
+            with second.context:
+                second.draw()
+                second.context.finish()
+
+        thread = threading.Thread(target=run)
+        thread.start()
+        first.draw()
+        thread.join()
+        first.context.finish()
+
+        self.assertEqual(first.state(), self.expected([first])[0][0])
+        with self.assertRaises(RuntimeError):
+            second.context.clear(0, 0, 1, 1)
+
+
+if __name__ == '__main__':
+    unittest.main()
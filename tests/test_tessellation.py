@@ -0,0 +1,105 @@
+"""VGPath.draw() with the tessellation cache on matches drawing the curves.
+
+Needs a build made with OPENVG_HEADLESS=1; skipped otherwise.
+
+    python -m unittest discover tests
+"""
+
+from array import array
+import unittest
+
+from OpenVG import VG
+
+SIZE = 64
+FORMAT = VG.VGImageFormat.VG_sRGBA_8888
+CLEAR_COLOR = VG.VGParamType.VG_CLEAR_COLOR
+TOLERANCE = 0.25
+
+# A flattened edge lies within TOLERANCE pixels of the curve, so an
+# antialiased pixel on it gains or loses at most about TOLERANCE * sqrt(2)
+# of its coverage; ShivaVG flattens the curves itself when the cache is
+# off, which adds as much again.  Interior and background pixels must not
+# change, so only the pixels along the outline may differ.
+MAX_DELTA = int(2 * TOLERANCE * 2 ** 0.5 * 255)
+MAX_CHANGED = SIZE * SIZE // 20
+
+Seg = VG.VGPathSegment
+ABSOLUTE = VG.VGPathAbsRel.VG_ABSOLUTE
+
+# name: (segments, coordinates), each closed and filled
+SHAPES = {
+    'quad': ([Seg.VG_MOVE_TO, Seg.VG_QUAD_TO, Seg.VG_CLOSE_PATH],
+             [8, 8, 32, 72, 56, 8]),
+    'cubic': ([Seg.VG_MOVE_TO, Seg.VG_CUBIC_TO, Seg.VG_CLOSE_PATH],
+              [8, 16, 0, 80, 64, -16, 56, 48]),
+    'arc': ([Seg.VG_MOVE_TO, Seg.VG_SCCWARC_TO, Seg.VG_CLOSE_PATH],
+            [8, 32, 24, 20, 30, 56, 32]),
+}
+
+
+def new_path(segments, coords):
+    path = VG.VGPath(0, VG.VGPathDatatype.VG_PATH_DATATYPE_F, 1.0, 0.0, 0, 0,
+                     VG.VGPathCapabilities.VG_PATH_CAPABILITY_ALL)
+    commands = array('B', [segment | ABSOLUTE for segment in segments])
+    path.append_data(len(commands), commands, array('f', coords))
+    return path
+
+
+class Tessellation(unittest.TestCase):
+
+    def setUp(self):
+        try:
+            self.context = VG.VGContext(SIZE, SIZE, headless=True)
+        except RuntimeError as error:
+            self.skipTest(str(error))
+        self.paint = VG.VGPaint()
+        self.paint.color = 0xffffffff
+        self.context.paint_fill = self.paint
+        self.context[CLEAR_COLOR] = [0.0, 0.0, 0.0, 1.0]
+
+    def tearDown(self):
+        del self.paint
+        del self.context
+
+    def render(self, path, tolerance):
+        context = self.context
+        context.clear(0, 0, SIZE, SIZE)
+        if path is not None:
+            path.tessellation_tolerance = tolerance
+            path.draw()
+        context.finish()
+        return bytearray(context.read_pixels(SIZE * 4, FORMAT, 0, 0, SIZE, SIZE))
+
+    def check(self, name):
+        path = new_path(*SHAPES[name])
+        curves = self.render(path, 0.0)
+        flattened = self.render(path, TOLERANCE)
+        background = self.render(None, 0.0)
+        self.assertTrue(curves != background, "%s drew nothing" % name)
+
+        changed = 0
+        largest = 0
+        for idx in range(0, len(curves), 4):
+            delta = max(abs(curves[idx + k] - flattened[idx + k])
+                        for k in range(4))
+            if delta:
+                changed += 1
+                largest = max(largest, delta)
+
+        self.assertLessEqual(largest, MAX_DELTA,
+                             "%s: a pixel changed by %d" % (name, largest))
+        self.assertLessEqual(changed, MAX_CHANGED,
+                             "%s: %d pixels changed" % (name, changed))
+
+    def test_quad(self):
+        self.check('quad')
+
+    def test_cubic(self):
+        self.check('cubic')
+
+    def test_arc(self):
+        self.check('arc')
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2012 Dan Eicher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file COPYING;
+ * if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * Argument parsing of the METH_FAST methods, see fast_parser.  The
+ * messages follow those of PyArg_ParseTupleAndKeywords().
+ */
+
+#include "openvg_module.h"
+#include <limits.h>
+
+static bool
+fast_check_count(const struct fast_parser *parser, Py_ssize_t nargs)
+{
+    if (nargs > parser->total) {
+        PyErr_Format(PyExc_TypeError,
+                     "%.200s() takes at most %d argument%s (%zd given)",
+                     parser->name, parser->total,
+                     parser->total == 1 ? "" : "s", nargs);
+        return false;
+    }
+    return true;
+}
+
+static bool
+fast_check_required(const struct fast_parser *parser, PyObject **argv)
+{
+    int idx;
+
+    for (idx = 0; idx < parser->required; idx++) {
+        if (argv[idx] == NULL) {
+            PyErr_Format(PyExc_TypeError,
+                         "%.200s() missing required argument '%s' (pos %d)",
+                         parser->name, parser->keywords[idx], idx + 1);
+            return false;
+        }
+    }
+    return true;
+}
+
+#if PY_VERSION_HEX >= 0x03070000
+
+bool
+fast_unpack(PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames,
+            const struct fast_parser *parser, PyObject **argv)
+{
+    Py_ssize_t num_keywords = kwnames ? PyTuple_GET_SIZE(kwnames) : 0;
+    Py_ssize_t key;
+    int idx;
+
+    if (!fast_check_count(parser, nargs))
+        return false;
+
+    for (idx = 0; idx < parser->total; idx++)
+        argv[idx] = idx < nargs ? args[idx] : NULL;
+
+    for (key = 0; key < num_keywords; key++) {
+        PyObject *name = PyTuple_GET_ITEM(kwnames, key);
+
+        for (idx = 0; idx < parser->total; idx++) {
+            if (PyUnicode_CompareWithASCIIString(name, parser->keywords[idx]) == 0)
+                break;
+        }
+
+        if (idx == parser->total) {
+            PyErr_Format(PyExc_TypeError,
+                         "'%U' is an invalid keyword argument for %.200s()",
+                         name, parser->name);
+            return false;
+        }
+        if (argv[idx] != NULL) {
+            PyErr_Format(PyExc_TypeError,
+                         "argument for %.200s() given by name ('%s') and position (%d)",
+                         parser->name, parser->keywords[idx], idx + 1);
+            return false;
+        }
+        argv[idx] = args[nargs + key];
+    }
+
+    return fast_check_required(parser, argv);
+}
+
+#else
+
+bool
+fast_unpack(PyObject *args, PyObject *kwargs, const struct fast_parser *parser,
+            PyObject **argv)
+{
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t num_keywords = kwargs ? PyDict_Size(kwargs) : 0;
+    int idx;
+
+    if (!fast_check_count(parser, nargs))
+        return false;
+
+    for (idx = 0; idx < parser->total; idx++) {
+        PyObject *value = NULL;
+
+        if (num_keywords)
+            value = PyDict_GetItemString(kwargs, parser->keywords[idx]);
+
+        if (value == NULL) {
+            argv[idx] = idx < nargs ? PyTuple_GET_ITEM(args, idx) : NULL;
+            continue;
+        }
+        if (idx < nargs) {
+            PyErr_Format(PyExc_TypeError,
+                         "argument for %.200s() given by name ('%s') and position (%d)",
+                         parser->name, parser->keywords[idx], idx + 1);
+            return false;
+        }
+        argv[idx] = value;
+        num_keywords--;
+    }
+
+    if (num_keywords) {
+        PyErr_Format(PyExc_TypeError,
+                     "%.200s() got an unexpected keyword argument",
+                     parser->name);
+        return false;
+    }
+
+    return fast_check_required(parser, argv);
+}
+
+#endif
+
+bool
+fast_float(PyObject *value, VGfloat *out)
+{
+    double result;
+
+    if (PyFloat_CheckExact(value)) {
+        *out = (VGfloat)PyFloat_AS_DOUBLE(value);
+        return true;
+    }
+
+    result = PyFloat_AsDouble(value);
+    if (result == -1.0 && PyErr_Occurred())
+        return false;
+
+    *out = (VGfloat)result;
+    return true;
+}
+
+bool
+fast_int(PyObject *value, VGint *out)
+{
+    long result;
+
+    if (PyFloat_Check(value)) {
+        PyErr_SetString(PyExc_TypeError, "integer argument expected, got float");
+        return false;
+    }
+
+    result = PyLong_AsLong(value);
+    if (result == -1 && PyErr_Occurred())
+        return false;
+
+    if (result > INT_MAX || result < INT_MIN) {
+        PyErr_SetString(PyExc_OverflowError, result > 0 ?
+                        "signed integer is greater than maximum" :
+                        "signed integer is less than minimum");
+        return false;
+    }
+
+    *out = (VGint)result;
+    return true;
+}
+
+bool
+fast_bitfield(PyObject *value, VGbitfield *out)
+{
+    unsigned long result;
+
+    if (PyFloat_Check(value)) {
+        PyErr_SetString(PyExc_TypeError, "integer argument expected, got float");
+        return false;
+    }
+
+    result = PyLong_AsUnsignedLongMask(value);
+    if (result == (unsigned long)-1 && PyErr_Occurred())
+        return false;
+
+    *out = (VGbitfield)result;
+    return true;
+}
+
+/* `out' is the address of a pointer to `type' objects, borrowed */
+bool
+fast_object(PyObject *value, PyTypeObject *type, void *out)
+{
+    if (!PyObject_TypeCheck(value, type)) {
+        PyErr_Format(PyExc_TypeError, "argument must be %.50s, not %.50s",
+                     type->tp_name, Py_TYPE(value)->tp_name);
+        return false;
+    }
+
+    *(PyObject **)out = value;
+    return true;
+}
+
+PyObject *
+fast_float_tuple(const VGfloat *values, int count)
+{
+    PyObject *py_retval = PyTuple_New(count);
+    int idx;
+
+    if (py_retval == NULL)
+        return NULL;
+
+    for (idx = 0; idx < count; idx++) {
+        PyObject *item = PyFloat_FromDouble(values[idx]);
+
+        if (item == NULL) {
+            Py_DECREF(py_retval);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(py_retval, idx, item);
+    }
+
+    return py_retval;
+}
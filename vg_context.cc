@@ -20,6 +20,12 @@
 
 #include "openvg_module.h"
 
+#ifdef HAVE_OSMESA
+#include <GL/osmesa.h>
+#endif
+
+static int context_check_current(PyVGContext *self);
+
 PyDoc_STRVAR(PyVGContext__get_paint_fill__doc__,
 ".. attribute:: paint_fill\n"
 "\n"
@@ -31,7 +37,11 @@ PyVGContext__get_paint_fill(PyVGContext *self, void * UNUSED(closure))
 {
     PyVGPaint *py_VGPaint;
     
+    if (context_check_current(self) < 0)
+        return NULL;
+
     py_VGPaint = PyObject_New(PyVGPaint, &PyVGPaint_Type);
+    backend_wait();
     py_VGPaint->obj = vgGetPaint(VG_FILL_PATH);
 
     if (check_error()) {
@@ -39,24 +49,26 @@ PyVGContext__get_paint_fill(PyVGContext *self, void * UNUSED(closure))
         return NULL;
     }
 
-    return Py_BuildValue((char *) "N", py_VGPaint);
+    return (PyObject *) py_VGPaint;
 }
 static int
 PyVGContext__set_paint_fill(PyVGContext *self, PyObject *value, void * UNUSED(closure))
 {
-    PyObject *py_retval;
     PyVGPaint *py_VGPaint;
-    
-    py_retval = Py_BuildValue((char *) "(O)", value);
-    if (!PyArg_ParseTuple(py_retval, (char *) "O!", &PyVGPaint_Type, &py_VGPaint)) {
-        Py_DECREF(py_retval);
+
+    if (context_check_current(self) < 0)
+        return -1;
+
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError, "cannot delete attribute");
         return -1;
     }
+    if (!fast_object(value, &PyVGPaint_Type, &py_VGPaint))
+        return -1;
 
+    backend_wait();
     vgSetPaint(py_VGPaint->obj, VG_FILL_PATH);
 
-    Py_DECREF(py_retval);
-
     return check_error() ? -1 : 0;
 }
 
@@ -72,7 +84,11 @@ PyVGContext__get_paint_stroke(PyVGContext *self, void * UNUSED(closure))
 {
     PyVGPaint *py_VGPaint;
     
+    if (context_check_current(self) < 0)
+        return NULL;
+
     py_VGPaint = PyObject_New(PyVGPaint, &PyVGPaint_Type);
+    backend_wait();
     py_VGPaint->obj = vgGetPaint(VG_STROKE_PATH);
 
     if (check_error()) {
@@ -80,26 +96,49 @@ PyVGContext__get_paint_stroke(PyVGContext *self, void * UNUSED(closure))
         return NULL;
     }
 
-    return Py_BuildValue((char *) "N", py_VGPaint);
+    return (PyObject *) py_VGPaint;
 }
 static int
 PyVGContext__set_paint_stroke(PyVGContext *self, PyObject *value, void * UNUSED(closure))
 {
-    PyObject *py_retval;
     PyVGPaint *py_VGPaint;
-    
-    py_retval = Py_BuildValue((char *) "(O)", value);
-    if (!PyArg_ParseTuple(py_retval, (char *) "O!", &PyVGPaint_Type, &py_VGPaint)) {
-        Py_DECREF(py_retval);
+
+    if (context_check_current(self) < 0)
+        return -1;
+
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError, "cannot delete attribute");
         return -1;
     }
+    if (!fast_object(value, &PyVGPaint_Type, &py_VGPaint))
+        return -1;
 
+    backend_wait();
     vgSetPaint(py_VGPaint->obj, VG_STROKE_PATH);
 
-    Py_DECREF(py_retval);
-
     return check_error() ? -1 : 0;
 }
+
+
+PyDoc_STRVAR(PyVGContext_headless__doc__,
+".. attribute:: headless\n"
+"\n"
+"   True when the context renders into an in-memory surface with the\n"
+"   software (OSMesa) backend.  Use read_pixels() to fetch the result.\n"
+"\n"
+"   The backend is chosen when the module is built: headless contexts\n"
+"   need a build made with OPENVG_HEADLESS=1, which links OSMesa in place\n"
+"   of libGL.  Such a build draws GL contexts through whatever OSMesa\n"
+"   context the application made current.\n"
+"\n"
+"   :type bool: Read only.\n"
+);
+
+static PyObject*
+PyVGContext__get_headless(PyVGContext *self, void * UNUSED(closure))
+{
+    return PyBool_FromLong(self->headless != NULL);
+}
 static PyGetSetDef PyVGContext__getsets[] = {
     {
         (char*) "paint_fill", /* attribute name */
@@ -115,60 +154,593 @@ static PyGetSetDef PyVGContext__getsets[] = {
         PyVGContext__get_paint_stroke__doc__, /* optional doc string */
         NULL /* optional additional data for getter and setter */
     },
+    {
+        (char*) "headless", /* attribute name */
+        (getter) PyVGContext__get_headless, /* C function to get the attribute */
+        (setter) NULL, /* C function to set the attribute */
+        PyVGContext_headless__doc__, /* optional doc string */
+        NULL /* optional additional data for getter and setter */
+    },
     { NULL, NULL, NULL, NULL, NULL }
 };
 
+/*
+ * ShivaVG has a single OpenVG context per process.  Each VGContext has its
+ * own surface and its own copy of the context state: the current one owns
+ * the ShivaVG context, the others keep their state in a context_state
+ * until `with context:' makes them current again.  Paths, paints and
+ * images are shared by all contexts.
+ */
+static const VGParamType state_int_params[] = {
+    VG_MATRIX_MODE, VG_FILL_RULE, VG_IMAGE_QUALITY, VG_RENDERING_QUALITY,
+    VG_BLEND_MODE, VG_IMAGE_MODE, VG_STROKE_CAP_STYLE, VG_STROKE_JOIN_STYLE,
+    VG_STROKE_DASH_PHASE_RESET, VG_MASKING, VG_SCISSORING, VG_PIXEL_LAYOUT,
+    VG_FILTER_FORMAT_LINEAR, VG_FILTER_FORMAT_PREMULTIPLIED,
+    VG_FILTER_CHANNEL_MASK,
+};
+
+static const VGParamType state_float_params[] = {
+    VG_STROKE_LINE_WIDTH, VG_STROKE_MITER_LIMIT, VG_STROKE_DASH_PHASE,
+};
+
+static const VGParamType state_vector_params[] = {
+    VG_SCISSOR_RECTS, VG_STROKE_DASH_PATTERN, VG_TILE_FILL_COLOR,
+    VG_CLEAR_COLOR,
+};
+
+static const VGMatrixMode state_matrices[] = {
+    VG_MATRIX_PATH_USER_TO_SURFACE, VG_MATRIX_IMAGE_USER_TO_SURFACE,
+    VG_MATRIX_FILL_PAINT_TO_USER, VG_MATRIX_STROKE_PAINT_TO_USER,
+};
+
+#define STATE_COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+struct context_state {
+    bool saved;                 /* false until the context is first replaced */
+    VGErrorCode error;          /* first error raised while it was loaded */
+    VGint ints[STATE_COUNT(state_int_params)];
+    VGfloat floats[STATE_COUNT(state_float_params)];
+    VGfloat *vectors[STATE_COUNT(state_vector_params)];
+    VGint vector_sizes[STATE_COUNT(state_vector_params)];
+    VGint vector_capacities[STATE_COUNT(state_vector_params)];
+    VGfloat matrices[STATE_COUNT(state_matrices)][9];
+    VGPaint fill, stroke;
+};
+
+/*
+ * Each thread draws into the context it entered last, or into the first
+ * one created when it is outside `with'.  ShivaVG holds the state of
+ * loaded_context: backend_wait() loads the context of a thread calling
+ * after another one, and `with' loads the context entered or returned
+ * to.  Contexts used on different threads only take turns for each
+ * backend call, not for whole `with' blocks.
+ */
+static PyVGContext *loaded_context = NULL;      /* state held by ShivaVG */
+static PyVGContext *thread_context = NULL;      /* current on backend_thread */
+static PyVGContext *default_context = NULL;     /* current outside `with' */
+static PyObject *context_key = NULL;    /* thread dict entry, entered contexts */
+static int num_contexts = 0;            /* VGContexts sharing ShivaVG */
+static bool contexts_headless;
+static struct context_state default_state;
+
+static unsigned long context_gl_thread;  /* thread owning the GL backend */
+static int context_threads = -1;        /* LP_NUM_THREADS read by the driver */
+
+#ifdef HAVE_OSMESA
+/* every headless GL context shares textures with this one */
+static OSMesaContext share_context = NULL;
+static unsigned char share_pixel[4];
+#endif
+
+static void
+context_clear_state(struct context_state *state)
+{
+    size_t idx;
+
+    for (idx = 0; idx < STATE_COUNT(state_vector_params); idx++) {
+        PyMem_Free(state->vectors[idx]);
+        state->vectors[idx] = NULL;
+    }
+}
+
+/*
+ * Vectors get room for the longest ones ShivaVG takes, so that loading
+ * another context never has to allocate.
+ */
+static int
+context_alloc_state(struct context_state *state)
+{
+    size_t idx;
+
+    memset(state, 0, sizeof(*state));
+
+    backend_wait();
+    for (idx = 0; idx < STATE_COUNT(state_vector_params); idx++) {
+        VGint capacity;
+
+        switch (state_vector_params[idx]) {
+            case VG_SCISSOR_RECTS:
+                capacity = 4 * vgGeti(VG_MAX_SCISSOR_RECTS);
+                break;
+            case VG_STROKE_DASH_PATTERN:
+                capacity = vgGeti(VG_MAX_DASH_COUNT);
+                break;
+            default:
+                capacity = 4;
+                break;
+        }
+
+        state->vectors[idx] = PyMem_New(VGfloat, capacity > 0 ? capacity : 1);
+        if (state->vectors[idx] == NULL) {
+            context_clear_state(state);
+            PyErr_NoMemory();
+            return -1;
+        }
+        state->vector_capacities[idx] = capacity;
+    }
+    return 0;
+}
+
+/*
+ * The state functions and context_load() run within backend_wait() or
+ * right after it, so they call ShivaVG without waiting themselves.
+ */
+static void
+context_save_state(struct context_state *state)
+{
+    size_t idx;
+    VGint mode;
+
+    for (idx = 0; idx < STATE_COUNT(state_vector_params); idx++) {
+        VGint size = vgGetVectorSize(state_vector_params[idx]);
+
+        if (size > state->vector_capacities[idx])
+            size = state->vector_capacities[idx];
+        if (size > 0)
+            vgGetfv(state_vector_params[idx], size, state->vectors[idx]);
+        state->vector_sizes[idx] = size > 0 ? size : 0;
+    }
+
+    for (idx = 0; idx < STATE_COUNT(state_int_params); idx++)
+        state->ints[idx] = vgGeti(state_int_params[idx]);
+    for (idx = 0; idx < STATE_COUNT(state_float_params); idx++)
+        state->floats[idx] = vgGetf(state_float_params[idx]);
+
+    mode = vgGeti(VG_MATRIX_MODE);
+    for (idx = 0; idx < STATE_COUNT(state_matrices); idx++) {
+        vgSeti(VG_MATRIX_MODE, state_matrices[idx]);
+        vgGetMatrix(state->matrices[idx]);
+    }
+    vgSeti(VG_MATRIX_MODE, mode);
+
+    state->fill = vgGetPaint(VG_FILL_PATH);
+    state->stroke = vgGetPaint(VG_STROKE_PATH);
+    state->saved = true;
+}
+
+static void
+context_restore_state(const struct context_state *state)
+{
+    size_t idx;
+
+    for (idx = 0; idx < STATE_COUNT(state_matrices); idx++) {
+        vgSeti(VG_MATRIX_MODE, state_matrices[idx]);
+        vgLoadMatrix(state->matrices[idx]);
+    }
+
+    /* VG_MATRIX_MODE comes first and is set last */
+    for (idx = STATE_COUNT(state_int_params); idx-- > 0; )
+        vgSeti(state_int_params[idx], state->ints[idx]);
+    for (idx = 0; idx < STATE_COUNT(state_float_params); idx++)
+        vgSetf(state_float_params[idx], state->floats[idx]);
+    for (idx = 0; idx < STATE_COUNT(state_vector_params); idx++)
+        vgSetfv(state_vector_params[idx], state->vector_sizes[idx], state->vectors[idx]);
+
+    vgSetPaint(state->fill, VG_FILL_PATH);
+    vgSetPaint(state->stroke, VG_STROKE_PATH);
+
+    /* the saved paints may have been destroyed since */
+    vgGetError();
+}
+
+/* Size of what `self' draws into: its surface or a render target. */
+static const int *
+context_bound_dimensions(PyVGContext *self)
+{
+    return self->target ? self->target_dimensions : self->dimensions;
+}
+
+/* Make the headless surface of `self' the GL drawable of this thread. */
+static bool
+context_bind_gl(PyVGContext *self)
+{
+#ifdef HAVE_OSMESA
+    const int *dimensions = context_bound_dimensions(self);
+
+    if (!OSMesaMakeCurrent((OSMesaContext)self->headless,
+                           self->target ? self->target : self->surface,
+                           GL_UNSIGNED_BYTE, dimensions[0], dimensions[1])) {
+        return false;
+    }
+#endif
+    backend_thread = (unsigned long)PyThread_get_thread_ident();
+    return true;
+}
+
+static int
+context_bind_surface(PyVGContext *self)
+{
+    backend_wait();
+    if (!context_bind_gl(self)) {
+        PyErr_SetString(PyExc_RuntimeError,
+            "Unable to bind headless surface");
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Bind the surface of `self' and swap its state into ShivaVG.  Errors
+ * still pending belong to the context replaced and are kept with it.
+ * Returns false if the surface could not be bound.
+ */
+static bool
+context_load(PyVGContext *self)
+{
+    bool bound = self->headless == NULL || context_bind_gl(self);
+
+    if (self == loaded_context)
+        return bound;
+
+    if (loaded_context != NULL) {
+        struct context_state *state = loaded_context->state;
+        VGErrorCode error = vgGetError();
+
+        if (state->error == VG_NO_ERROR)
+            state->error = error;
+        context_save_state(state);
+    }
+
+    vgResizeSurfaceSH(context_bound_dimensions(self)[0], context_bound_dimensions(self)[1]);
+    context_restore_state(self->state->saved ? self->state : &default_state);
+
+    loaded_context = self;
+    return bound;
+}
+
+/* The list of contexts the calling thread entered, NULL if it has none. */
 static PyObject *
-PyVGContext__tp_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+context_thread_stack(bool create)
+{
+    PyObject *dict = PyThreadState_GetDict();
+    PyObject *stack;
+
+    if (dict == NULL) {
+        if (create)
+            PyErr_SetString(PyExc_RuntimeError, "thread has no state dictionary");
+        return NULL;
+    }
+
+    stack = PyDict_GetItem(dict, context_key);
+    if (stack != NULL || !create)
+        return stack;
+
+    if ((stack = PyList_New(0)) == NULL)
+        return NULL;
+    if (PyDict_SetItem(dict, context_key, stack) < 0) {
+        Py_DECREF(stack);
+        return NULL;
+    }
+    Py_DECREF(stack);
+    return stack;
+}
+
+/* The context the calling thread draws into. */
+static PyVGContext *
+context_thread_current(void)
+{
+    PyObject *stack = context_thread_stack(false);
+
+    if (stack != NULL && PyList_GET_SIZE(stack) > 0)
+        return (PyVGContext *)PyList_GET_ITEM(stack, PyList_GET_SIZE(stack) - 1);
+    return default_context;
+}
+
+/*
+ * Load the context of the calling thread.  Only a headless one can move,
+ * a GL VGContext stays with the thread that created it.  A failed bind is
+ * retried by the next call.
+ */
+void
+backend_bind_thread(void)
 {
-    static PyVGContext *self = NULL;
+    backend_thread = (unsigned long)PyThread_get_thread_ident();
+    thread_context = context_thread_current();
 
-    if (self == NULL) {
-        self = (PyVGContext *)type->tp_alloc(type, 0);
+    if (thread_context != NULL && !context_load(thread_context))
+        backend_thread = 0;
+}
+
+/* Take the error kept for the loaded context while it was replaced. */
+VGErrorCode
+context_take_error(void)
+{
+    VGErrorCode error = VG_NO_ERROR;
+
+    if (loaded_context != NULL) {
+        error = loaded_context->state->error;
+        loaded_context->state->error = VG_NO_ERROR;
     }
+    return error;
+}
 
-    /* tp_dealloc never gets called */
-    Py_XINCREF(self);
+/* Raise unless the backend of `self' can be used from this thread. */
+static int
+context_check_thread(PyVGContext *self)
+{
+    if (!self->headless && context_gl_thread != (unsigned long)PyThread_get_thread_ident()) {
+        PyErr_SetString(PyExc_RuntimeError,
+            "a GL VGContext can only be used from the thread that created it");
+        return -1;
+    }
+    return 0;
+}
 
-    return (PyObject*)self;
+/*
+ * Raise unless `self' is the context the calling thread draws into.
+ * Methods of another VGContext would draw into that one, `with context:'
+ * switches.  Loads the context if another thread used ShivaVG last.
+ */
+static int
+context_check_current(PyVGContext *self)
+{
+    backend_wait();
+    if (self != thread_context) {
+        PyErr_SetString(PyExc_RuntimeError,
+            "VGContext is not current, draw into it inside `with context:'");
+        return -1;
+    }
+    return context_check_thread(self);
+}
+
+/* Resize the surface, reallocating the pixels of a headless one. */
+static int
+context_resize(PyVGContext *self, VGint width, VGint height)
+{
+    /* the surface may be drawn into by a thread without the GIL */
+    backend_wait();
+    if (self->headless) {
+        unsigned char *surface;
+
+        if (width <= 0 || height <= 0 || (size_t)width > PY_SSIZE_T_MAX / 4 / (size_t)height) {
+            PyErr_SetString(PyExc_ValueError, "VG_ILLEGAL_ARGUMENT_ERROR");
+            return -1;
+        }
+
+        surface = (unsigned char *)PyMem_Realloc(self->surface, (size_t)width * height * 4);
+        if (surface == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->surface = surface;
+    }
+
+    self->dimensions[0] = width;
+    self->dimensions[1] = height;
+
+    /* a bound render target keeps its own size */
+    if (self != loaded_context || self->target != NULL)
+        return 0;
+
+    if (self->headless && context_bind_surface(self) < 0)
+        return -1;
+
+    VG_BEGIN_ALLOW_THREADS
+    vgResizeSurfaceSH(width, height);
+    VG_END_ALLOW_THREADS
+
+    return 0;
+}
+
+PyVGContext *
+get_current_context(void)
+{
+    backend_wait();
+    return thread_context;
+}
+
+/*
+ * Draw the headless context `self' into `pixels', or back into its own
+ * surface when `pixels' is NULL.  `self' must be current.
+ */
+int
+context_bind_target(PyVGContext *self, unsigned char *pixels, VGint width, VGint height)
+{
+    self->target = pixels;
+    self->target_dimensions[0] = width;
+    self->target_dimensions[1] = height;
+
+    if (context_bind_surface(self) < 0)
+        return -1;
+
+    backend_wait();
+    vgResizeSurfaceSH(context_bound_dimensions(self)[0], context_bound_dimensions(self)[1]);
+    return 0;
+}
+
+static PyObject *
+PyVGContext__tp_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    if (context_key == NULL &&
+        (context_key = PyUnicode_InternFromString("OpenVG.VGContext")) == NULL) {
+        return NULL;
+    }
+
+    return type->tp_alloc(type, 0);
 }
 
 static int
 PyVGContext__tp_init(PyVGContext *self, PyObject *args, PyObject *kwargs)
 {
     VGint width, height;
+    PyObject *py_headless = Py_False;
+    int headless, threads = 0;
 
-    const char *keywords[] = {"width", "height", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "ii", (char **) keywords, &width, &height)) {
+    const char *keywords[] = {"width", "height", "headless", "threads", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "ii|Oi", (char **) keywords, &width, &height, &py_headless, &threads)) {
+        return -1;
+    }
+
+    if ((headless = PyObject_IsTrue(py_headless)) < 0)
+        return -1;
+
+    if (threads < 0 || (threads && !headless)) {
+        PyErr_SetString(PyExc_ValueError,
+            "threads must be >= 0 and requires headless=True");
+        return -1;
+    }
+
+    if (self->init) {
+        if (headless != (self->headless != NULL)) {
+            PyErr_SetString(PyExc_RuntimeError,
+                "VGContext already created with a different backend");
+            return -1;
+        }
+        if ((self->dimensions[0] != width || self->dimensions[1] != height) &&
+            context_resize(self, width, height) < 0) {
+            return -1;
+        }
+        return check_error() ? -1 : 0;
+    }
+
+    if (num_contexts && headless != contexts_headless) {
+        PyErr_SetString(PyExc_RuntimeError,
+            "VGContexts of one process must all use the same backend");
+        return -1;
+    }
+
+    if ((self->state = PyMem_New(struct context_state, 1)) == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memset(self->state, 0, sizeof(struct context_state));
+
+    backend_wait();
+    if (headless) {
+#ifdef HAVE_OSMESA
+        /* llvmpipe bins primitives into screen tiles and rasterizes
+         * them on this many threads; tiles are independent so the
+         * output does not depend on the count.  Only llvmpipe reads
+         * LP_NUM_THREADS, once, when the first GL context of the process
+         * is created; later values are ignored. */
+        if (context_threads < 0) {
+            const char *env;
+
+            if (threads) {
+                char value[16];
+
+                /* setenv() races getenv() on other threads, do it once */
+                PyOS_snprintf(value, sizeof(value), "%d", threads);
+                setenv("LP_NUM_THREADS", value, 1);
+            }
+            env = getenv("LP_NUM_THREADS");
+            context_threads = env != NULL ? atoi(env) : 0;
+        }
+        else if (threads && threads != context_threads) {
+            char message[96];
+
+            if (context_threads)
+                PyOS_snprintf(message, sizeof(message),
+                    "threads=%d ignored, the GL driver already uses %d", threads, context_threads);
+            else
+                PyOS_snprintf(message, sizeof(message),
+                    "threads=%d ignored, the GL driver already uses its default", threads);
+            if (PyErr_WarnEx(PyExc_RuntimeWarning, message, 1) < 0)
+                return -1;
+        }
+        /* ShivaVG fills through the stencil buffer */
+        if (share_context == NULL)
+            share_context = OSMesaCreateContextExt(OSMESA_RGBA, 0, 8, 0, NULL);
+        if (share_context != NULL)
+            self->headless = OSMesaCreateContextExt(OSMESA_RGBA, 0, 8, 0, share_context);
+        if (self->headless == NULL) {
+            PyErr_SetString(PyExc_RuntimeError,
+                "Unable to create headless GL context");
+            return -1;
+        }
+#else
+        PyErr_SetString(PyExc_RuntimeError,
+            "OpenVG was built without headless support, rebuild it with OPENVG_HEADLESS=1");
         return -1;
+#endif
     }
 
-    if (!self->init) {
+    if (context_resize(self, width, height) < 0)
+        return -1;
+
+    /* later contexts are loaded by the first thread drawing into them */
+    if (num_contexts == 0) {
+        if (self->headless && context_bind_surface(self) < 0)
+            return -1;
         if (!vgCreateContextSH(width, height)) {
             PyErr_SetString(PyExc_RuntimeError,
                 "Unable to create OpenVG context");
             return -1;
         }
-        self->init = 1;
+        if (context_alloc_state(&default_state) < 0) {
+            vgDestroyContextSH();
+            return -1;
+        }
+        context_save_state(&default_state);
+        loaded_context = default_context = self;
+        thread_context = context_thread_current();
+        contexts_headless = headless;
+        context_gl_thread = (unsigned long)PyThread_get_thread_ident();
     }
-    else if (self->dimensions[0] != width || self->dimensions[1] != height) {
-        vgResizeSurfaceSH(width, height);
-        self->dimensions[0] = width;
-        self->dimensions[1] = height;
+
+    if (context_alloc_state(self->state) < 0) {
+        if (num_contexts == 0) {
+            loaded_context = default_context = thread_context = NULL;
+            vgDestroyContextSH();
+            context_clear_state(&default_state);
+        }
+        return -1;
     }
+
+    num_contexts++;
+    self->init = 1;
     return check_error() ? -1 : 0;
 }
 
 static PyObject *
 PyVGContext__enter__(PyVGContext *self)
 {
+    PyObject *stack;
+
     if (self->init == 0) {
         PyErr_SetString(PyExc_RuntimeError,
                         "VGContext.__enter__(): VGContext not properly constructed.");
         return NULL;
     }
 
+    if (context_check_thread(self) < 0 || check_pending_error(true) ||
+        (stack = context_thread_stack(true)) == NULL ||
+        PyList_Append(stack, (PyObject *)self) < 0) {
+        return NULL;
+    }
+
+    backend_wait();
+    thread_context = self;
+    if (!context_load(self)) {
+        PySequence_DelItem(stack, PyList_GET_SIZE(stack) - 1);
+        thread_context = context_thread_current();
+        backend_thread = 0;
+        PyErr_SetString(PyExc_RuntimeError,
+            "Unable to bind headless surface");
+        return NULL;
+    }
+
     Py_INCREF(self);
     return (PyObject *)self;
 }
@@ -176,6 +748,43 @@ PyVGContext__enter__(PyVGContext *self)
 static PyObject *
 PyVGContext__exit__(PyVGContext *self, PyObject *args)
 {
+    PyObject *stack = context_thread_stack(false);
+    bool failed = false;
+
+    if (stack == NULL || PyList_GET_SIZE(stack) == 0 ||
+        PyList_GET_ITEM(stack, PyList_GET_SIZE(stack) - 1) != (PyObject *)self) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "VGContext.__exit__(): context was not entered last on this thread.");
+        return NULL;
+    }
+
+    /* don't replace an exception that is already propagating */
+    backend_wait();
+    if (PyTuple_GET_SIZE(args) == 0 || PyTuple_GET_ITEM(args, 0) == Py_None) {
+        failed = check_pending_error(true) != VG_NO_ERROR;
+    }
+    else {
+        vgGetError();
+        context_take_error();
+    }
+
+    /* the stack may hold the last reference */
+    Py_INCREF(self);
+    PySequence_DelItem(stack, PyList_GET_SIZE(stack) - 1);
+
+    thread_context = context_thread_current();
+    if (thread_context != NULL && !context_load(thread_context)) {
+        backend_thread = 0;
+        if (!failed)
+            PyErr_SetString(PyExc_RuntimeError,
+                "Unable to bind headless surface");
+        failed = true;
+    }
+    Py_DECREF(self);
+
+    if (failed)
+        return NULL;
+
     Py_RETURN_NONE;
 }
 
@@ -196,18 +805,40 @@ PyDoc_STRVAR(OpenVG_vgClear__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgClear, "VGContext.clear");
+
+static const char *const OpenVG_vgClear_keywords[] = {"x", "y", "width", "height", NULL};
+static const struct fast_parser OpenVG_vgClear_parser = {"clear", OpenVG_vgClear_keywords, 4, 4};
+
 static PyObject *
-OpenVG_vgClear(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgClear(PyVGContext *self, FAST_ARGS)
 {
+    PyObject *argv[4];
     VGint x, y, width, height;
 
-    const char *keywords[] = {"x", "y", "width", "height", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiii", (char **) keywords, &x, &y, &width, &height)) {
+    stats_scope stats(&stats_vgClear);
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgClear_parser, argv) ||
+        !fast_int(argv[0], &x) ||
+        !fast_int(argv[1], &y) ||
+        !fast_int(argv[2], &width) ||
+        !fast_int(argv[3], &height)) {
         return NULL;
     }
 
-    vgClear(x, y, width, height);
+    /* a few pixels don't pay for releasing the GIL */
+    if ((double)width * height < BACKEND_RELEASE_PIXELS) {
+        backend_wait();
+        vgClear(x, y, width, height);
+    }
+    else {
+        VG_BEGIN_ALLOW_THREADS
+        vgClear(x, y, width, height);
+        VG_END_ALLOW_THREADS
+    }
 
     if (check_error()) {
         return NULL;
@@ -226,6 +857,10 @@ PyDoc_STRVAR(OpenVG_vgLoadIdentity__doc__,
 static PyObject *
 OpenVG_vgLoadIdentity(PyVGContext *self, PyObject *args, PyObject *kwargs)
 {
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    backend_wait();
     vgLoadIdentity();
 
     Py_RETURN_NONE;
@@ -241,17 +876,24 @@ PyDoc_STRVAR(OpenVG_vgRotate__doc__,
 "   :type angle: float\n"
 );
 
+static const char *const OpenVG_vgRotate_keywords[] = {"angle", NULL};
+static const struct fast_parser OpenVG_vgRotate_parser = {"rotate", OpenVG_vgRotate_keywords, 1, 1};
+
 static PyObject *
-OpenVG_vgRotate(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgRotate(PyVGContext *self, FAST_ARGS)
 {
+    PyObject *argv[1];
     VGfloat angle;
 
-    const char *keywords[] = {"angle", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "f", (char **) keywords, &angle)) {
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgRotate_parser, argv) ||
+        !fast_float(argv[0], &angle)) {
         return NULL;
     }
 
+    backend_wait();
     vgRotate(angle);
 
     Py_RETURN_NONE;
@@ -277,6 +919,10 @@ OpenVG_vgGetMatrix(PyVGContext *self, PyObject *args, PyObject *kwargs)
     PyObject *py_list;
     int idx;
 
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    backend_wait();
     vgGetMatrix(matrix);
 
     if (check_error())
@@ -286,7 +932,7 @@ OpenVG_vgGetMatrix(PyVGContext *self, PyObject *args, PyObject *kwargs)
     for (idx = 0; idx < MATRIX_SIZE; idx++) {
         PyList_SET_ITEM(py_list, idx, PyFloat_FromDouble(matrix[idx]));
     }
-    py_retval = Py_BuildValue((char *) "N", py_list);
+    py_retval = py_list;
     return py_retval;
 }
 
@@ -316,19 +962,39 @@ PyDoc_STRVAR(OpenVG_vgSetPixels__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgSetPixels, "VGContext.set_pixels");
+
+static const char *const OpenVG_vgSetPixels_keywords[] = {"dx", "dy", "src", "sx", "sy", "width", "height", NULL};
+static const struct fast_parser OpenVG_vgSetPixels_parser = {"set_pixels", OpenVG_vgSetPixels_keywords, 7, 7};
+
 static PyObject *
-OpenVG_vgSetPixels(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgSetPixels(PyVGContext *self, FAST_ARGS)
 {
+    PyObject *argv[7];
     PyVGImage *src;
     VGint dx, dy, sx, sy, width, height;
 
-    const char *keywords[] = {"dx", "dy", "src", "sx", "sy", "width", "height", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiO!iiii", (char **) keywords, &dx, &dy, &PyVGImage_Type, &src, &sx, &sy, &width, &height)) {
+    stats_scope stats(&stats_vgSetPixels);
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgSetPixels_parser, argv) ||
+        !fast_int(argv[0], &dx) ||
+        !fast_int(argv[1], &dy) ||
+        !fast_object(argv[2], &PyVGImage_Type, &src) ||
+        !fast_int(argv[3], &sx) ||
+        !fast_int(argv[4], &sy) ||
+        !fast_int(argv[5], &width) ||
+        !fast_int(argv[6], &height)) {
         return NULL;
     }
 
+    stats.handle = src->obj;
+
+    VG_BEGIN_ALLOW_THREADS
     vgSetPixels(dx, dy, src->obj, sx, sy, width, height);
+    VG_END_ALLOW_THREADS
 
     if (check_error())
         return NULL;
@@ -348,16 +1014,22 @@ PyDoc_STRVAR(OpenVG_vgMultMatrix__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+static const char *const OpenVG_vgMultMatrix_keywords[] = {"matrix", NULL};
+static const struct fast_parser OpenVG_vgMultMatrix_parser = {"mult_matrix", OpenVG_vgMultMatrix_keywords, 1, 1};
+
 static PyObject *
-OpenVG_vgMultMatrix(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgMultMatrix(PyVGContext *self, FAST_ARGS)
 {
+    PyObject *argv[1];
     VGfloat matrix[MATRIX_SIZE];
     PyObject *py_list;
     int idx;
 
-    const char *keywords[] = {"matrix", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!", (char **) keywords, &PyList_Type, &py_list)) {
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgMultMatrix_parser, argv) ||
+        !fast_object(argv[0], &PyList_Type, &py_list)) {
         return NULL;
     }
     if (PyList_Size(py_list) != MATRIX_SIZE) {
@@ -373,6 +1045,7 @@ OpenVG_vgMultMatrix(PyVGContext *self, PyObject *args, PyObject *kwargs)
         matrix[idx] = (float) PyFloat_AsDouble(element);
     }
 
+    backend_wait();
     vgMultMatrix(matrix);
 
     if (check_error())
@@ -382,11 +1055,101 @@ OpenVG_vgMultMatrix(PyVGContext *self, PyObject *args, PyObject *kwargs)
 }
 
 
-PyDoc_STRVAR(OpenVG_vgReadPixels__doc__,
-".. function:: read_pixels(dataStride, dataFormat, sx, sy, width, height)\n"
+PyDoc_STRVAR(OpenVG_vgReadPixels__doc__,
+".. function:: read_pixels(dataStride, dataFormat, sx, sy, width, height[, transferFormat])\n"
+"\n"
+"   Copy pixel values to `data'.\n"
+"\n"
+"   :arg dataStride: Stride between pixel rows.\n"
+"   :type dataStride: int\n"
+"   :arg dataFormat: Pixel data format.\n"
+"   :type dataFormat: VGImageFormat\n"
+"   :arg sx: Start position x.\n"
+"   :type sx: int\n"
+"   :arg sy: Start position y.\n"
+"   :type sy: int\n"
+"   :arg width: Width of the sub-region.\n"
+"   :type width: int\n"
+"   :arg height: Height of the sub-region.\n"
+"   :arg transferFormat: Format exchanged with OpenVG, the bindings convert\n"
+"      between it and `dataFormat'.\n"
+"   :type transferFormat: VGImageFormat\n"
+"   :return: Raw pixel data.\n"
+"   :rtype: bytearray\n"
+"\n"
+"   :error: VG_UNSUPPORTED_IMAGE_FORMAT_ERROR.\n"
+"   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
+);
+
+STATS_ENTRY(stats_vgReadPixels, "VGContext.read_pixels");
+
+static PyObject *
+OpenVG_vgReadPixels(PyVGContext *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *py_retval;
+    char *data;
+    VGint dataStride;
+    VGImageFormat dataFormat;
+    VGint sx, sy, width, height;
+    VGint transferFormat = -1;
+    pixel_stage stage;
+    Py_ssize_t bytes, offset;
+
+    const char *keywords[] = {"dataStride", "dataFormat", "sx", "sy", "width", "height", "transferFormat", NULL};
+
+    stats_scope stats(&stats_vgReadPixels);
+    
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiiiii|i", (char **) keywords, &dataStride, &dataFormat, &sx, &sy, &width, &height, &transferFormat)) {
+        return NULL;
+    }
+
+    if ((bytes = pixel_data_size(dataStride, dataFormat, width, height, &offset)) < 0)
+        return NULL;
+    stats.bytes = bytes;
+
+    if (pixel_stage_init(&stage, dataFormat, transferFormat, width, height) < 0)
+        return NULL;
+
+    /* read straight into the result, nothing else can see it yet */
+    if ((py_retval = PyByteArray_FromStringAndSize(NULL, bytes)) == NULL) {
+        pixel_stage_free(&stage);
+        return NULL;
+    }
+
+    data = PyByteArray_AS_STRING(py_retval) + offset;
+
+    VG_BEGIN_ALLOW_THREADS
+    if (stage.data)
+        vgReadPixels(stage.data, stage.stride, stage.format, sx, sy, width, height);
+    else
+        vgReadPixels(data, dataStride, dataFormat, sx, sy, width, height);
+    VG_END_ALLOW_THREADS
+
+    if (check_error()) {
+        pixel_stage_free(&stage);
+        Py_DECREF(py_retval);
+        return NULL;
+    }
+
+    if (stage.data) {
+        pixel_stage_unpack(&stage, data, dataStride, dataFormat, width, height);
+        pixel_stage_free(&stage);
+    }
+
+    return py_retval;
+}
+
+
+PyDoc_STRVAR(OpenVG_vgReadPixelsInto__doc__,
+".. function:: read_pixels_into(buffer, dataStride, dataFormat, sx, sy, width, height[, transferFormat])\n"
 "\n"
-"   Copy pixel values to `data'.\n"
+"   Copy pixel values straight into `buffer'.\n"
 "\n"
+"   :arg buffer: Destination, any writable contiguous buffer.\n"
+"   :type buffer: bytearray, memoryview, mmap, ...\n"
 "   :arg dataStride: Stride between pixel rows.\n"
 "   :type dataStride: int\n"
 "   :arg dataFormat: Pixel data format.\n"
@@ -398,68 +1161,94 @@ PyDoc_STRVAR(OpenVG_vgReadPixels__doc__,
 "   :arg width: Width of the sub-region.\n"
 "   :type width: int\n"
 "   :arg height: Height of the sub-region.\n"
-"   :return: Raw pixel data.\n"
-"   :rtype: bytearray\n"
+"   :arg transferFormat: Format exchanged with OpenVG, the bindings convert\n"
+"      between it and `dataFormat'.\n"
+"   :type transferFormat: VGImageFormat\n"
+"   :return: Number of bytes spanned in `buffer'.\n"
+"   :rtype: int\n"
 "\n"
 "   :error: VG_UNSUPPORTED_IMAGE_FORMAT_ERROR.\n"
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgReadPixelsInto, "VGContext.read_pixels_into");
+
 static PyObject *
-OpenVG_vgReadPixels(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgReadPixelsInto(PyVGContext *self, PyObject *args, PyObject *kwargs)
 {
-    PyObject *py_retval;
-    char *data;
+    PyObject *buffer;
+    Py_buffer view;
     VGint dataStride;
     VGImageFormat dataFormat;
     VGint sx, sy, width, height;
-    int bytes;
+    VGint transferFormat = -1;
+    pixel_stage stage;
+    Py_ssize_t bytes, offset;
+
+    const char *keywords[] = {"buffer", "dataStride", "dataFormat", "sx", "sy", "width", "height", "transferFormat", NULL};
 
-    const char *keywords[] = {"dataStride", "dataFormat", "sx", "sy", "width", "height", NULL};
+    stats_scope stats(&stats_vgReadPixelsInto);
     
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiiiii", (char **) keywords, &dataStride, &dataFormat, &sx, &sy, &width, &height)) {
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "Oiiiiii|i", (char **) keywords, &buffer, &dataStride, &dataFormat, &sx, &sy, &width, &height, &transferFormat)) {
         return NULL;
     }
 
-    bytes = width*height;
-    switch (dataFormat) {
-        case VG_sL_8:
-        case VG_lL_8:
-        case VG_A_8:  /* 1 byte/pixel */
-            break;
-        case VG_sRGB_565:
-        case VG_sRGBA_5551:
-        case VG_sRGBA_4444:  /* 2 bytes/pixel */
-            bytes *= 2;
-            break;
-        default:  /* 4 bytes/pixel */
-            bytes *= 4;
+    if ((bytes = pixel_data_size(dataStride, dataFormat, width, height, &offset)) < 0)
+        return NULL;
+    stats.bytes = bytes;
+
+    if (PyObject_GetBuffer(buffer, &view, PyBUF_WRITABLE) < 0)
+        return NULL;
+
+    if (view.len < bytes) {
+        PyBuffer_Release(&view);
+        PyErr_Format(PyExc_ValueError,
+                     "VGContext.read_pixels_into(): buffer holds %zd bytes, %zd needed",
+                     view.len, bytes);
+        return NULL;
     }
 
-    data = (char *)malloc(sizeof(char) * bytes);
+    if (pixel_stage_init(&stage, dataFormat, transferFormat, width, height) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
 
-    vgReadPixels(data, dataStride, dataFormat, sx, sy, width, height);
+    VG_BEGIN_ALLOW_THREADS
+    if (stage.data)
+        vgReadPixels(stage.data, stage.stride, stage.format, sx, sy, width, height);
+    else
+        vgReadPixels((char *)view.buf + offset, dataStride, dataFormat,
+                     sx, sy, width, height);
+    VG_END_ALLOW_THREADS
 
     if (check_error()) {
-        free(data);
+        pixel_stage_free(&stage);
+        PyBuffer_Release(&view);
         return NULL;
     }
 
-    py_retval = Py_BuildValue((char *) "N", PyByteArray_FromStringAndSize(data, bytes));
+    if (stage.data) {
+        pixel_stage_unpack(&stage, (char *)view.buf + offset, dataStride,
+                           dataFormat, width, height);
+        pixel_stage_free(&stage);
+    }
 
-    free(data);
+    PyBuffer_Release(&view);
 
-    return py_retval;
+    return PyLong_FromSsize_t(bytes);
 }
 
 
 PyDoc_STRVAR(OpenVG_vgWritePixels__doc__,
-".. function:: write_pixels(data, dataStride, dataFormat, dx, dy, width, height)\n"
+".. function:: write_pixels(data, dataStride, dataFormat, dx, dy, width, height[, transferFormat])\n"
 "\n"
 "   Fill region with `data'.\n"
 "\n"
 "   :arg data: Raw pixel data.\n"
-"   :type data: bytes\n"
+"   :type data: bytes, bytearray, memoryview, mmap, ...\n"
 "   :arg dataStride: Stride between pixel rows.\n"
 "   :type dataStride: int\n"
 "   :arg dataFormat: Pixel data format.\n"
@@ -471,32 +1260,81 @@ PyDoc_STRVAR(OpenVG_vgWritePixels__doc__,
 "   :arg width: Width of the sub-region.\n"
 "   :type width: int\n"
 "   :arg height: Height of the sub-region.\n"
+"   :arg transferFormat: Format exchanged with OpenVG, the bindings convert\n"
+"      between it and `dataFormat'.\n"
+"   :type transferFormat: VGImageFormat\n"
 "\n"
 "   :error: VG_UNSUPPORTED_IMAGE_FORMAT_ERROR.\n"
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgWritePixels, "VGContext.write_pixels");
+
 static PyObject *
 OpenVG_vgWritePixels(PyVGContext *self, PyObject *args, PyObject *kwargs)
 {
     PyObject *data;
+    Py_buffer view;
+    Py_ssize_t bytes, offset;
     VGint dataStride;
     VGImageFormat dataFormat;
     VGint dx, dy, width, height;
+    VGint transferFormat = -1;
+    pixel_stage stage;
 
-    const char *keywords[] = {"data", "dataStride", "dataFormat", "dx", "dy", "width", "height", NULL};
+    const char *keywords[] = {"data", "dataStride", "dataFormat", "dx", "dy", "width", "height", "transferFormat", NULL};
+
+    stats_scope stats(&stats_vgWritePixels);
     
+    if (context_check_current(self) < 0)
+        return NULL;
+
     if (!PyArg_ParseTupleAndKeywords(args, kwargs,
-                                     (char *) "O!iiiiii",
+                                     (char *) "Oiiiiii|i",
                                      (char **) keywords,
-                                     &PyByteArray_Type, &data,
+                                     &data,
                                      &dataStride, &dataFormat,
-                                     &dx, &dy, &width, &height)) {
+                                     &dx, &dy, &width, &height,
+                                     &transferFormat)) {
+        return NULL;
+    }
+
+    if ((bytes = pixel_data_size(dataStride, dataFormat, width, height, &offset)) < 0)
+        return NULL;
+    stats.bytes = bytes;
+
+    /* the export also keeps `data' from being resized without the GIL */
+    if (PyObject_GetBuffer(data, &view, PyBUF_C_CONTIGUOUS) < 0)
         return NULL;
+
+    if (view.len < bytes) {
+        PyBuffer_Release(&view);
+        PyErr_Format(PyExc_ValueError,
+                     "VGContext.write_pixels(): data holds %zd bytes, %zd needed",
+                     view.len, bytes);
+        return NULL;
+    }
+
+    if (pixel_stage_init(&stage, dataFormat, transferFormat, width, height) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    if (stage.data) {
+        pixel_stage_pack(&stage, (char *)view.buf + offset, dataStride,
+                         dataFormat, width, height);
     }
 
-    vgWritePixels(PyByteArray_AsString(data),
-                  dataStride, dataFormat, dx, dy, width, height);
+    VG_BEGIN_ALLOW_THREADS
+    if (stage.data)
+        vgWritePixels(stage.data, stage.stride, stage.format, dx, dy, width, height);
+    else
+        vgWritePixels((char *)view.buf + offset, dataStride, dataFormat,
+                      dx, dy, width, height);
+    VG_END_ALLOW_THREADS
+
+    pixel_stage_free(&stage);
+    PyBuffer_Release(&view);
 
     if (check_error()) {
         return NULL;
@@ -528,19 +1366,39 @@ PyDoc_STRVAR(OpenVG_vgMask__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgMask, "VGContext.mask");
+
+static const char *const OpenVG_vgMask_keywords[] = {"mask", "operation", "x", "y", "width", "height", NULL};
+static const struct fast_parser OpenVG_vgMask_parser = {"mask", OpenVG_vgMask_keywords, 6, 6};
+
 static PyObject *
-OpenVG_vgMask(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgMask(PyVGContext *self, FAST_ARGS)
 {
+    PyObject *argv[6];
     PyVGImage *mask;
-    VGMaskOperation operation;
+    VGint operation;
     VGint x, y, width, height;
-    const char *keywords[] = {"mask", "operation", "x", "y", "width", "height", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!iiiii", (char **) keywords, &PyVGImage_Type, &mask, &operation, &x, &y, &width, &height)) {
+
+    stats_scope stats(&stats_vgMask);
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgMask_parser, argv) ||
+        !fast_object(argv[0], &PyVGImage_Type, &mask) ||
+        !fast_int(argv[1], &operation) ||
+        !fast_int(argv[2], &x) ||
+        !fast_int(argv[3], &y) ||
+        !fast_int(argv[4], &width) ||
+        !fast_int(argv[5], &height)) {
         return NULL;
     }
 
-    vgMask(mask->obj, operation, x, y, width, height);
+    stats.handle = mask->obj;
+
+    VG_BEGIN_ALLOW_THREADS
+    vgMask(mask->obj, (VGMaskOperation)operation, x, y, width, height);
+    VG_END_ALLOW_THREADS
 
     if (check_error()) {
         return NULL;
@@ -554,12 +1412,26 @@ PyDoc_STRVAR(OpenVG_vgFinish__doc__,
 ".. function:: finish()\n"
 "\n"
 "   Force outstanding requests to complete.\n"
+"\n"
+"   Reports any error held back while errors are deferred.\n"
 );
 
+STATS_ENTRY(stats_vgFinish, "VGContext.finish");
+
 static PyObject *
 OpenVG_vgFinish(PyVGContext *self, PyObject *args, PyObject *kwargs)
 {
+    stats_scope stats(&stats_vgFinish);
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    VG_BEGIN_ALLOW_THREADS
     vgFinish();
+    VG_END_ALLOW_THREADS
+
+    if (check_pending_error(false))
+        return NULL;
 
     Py_RETURN_NONE;
 }
@@ -576,16 +1448,25 @@ PyDoc_STRVAR(OpenVG_vgScale__doc__,
 "   :type sy: float\n"
 );
 
+static const char *const OpenVG_vgScale_keywords[] = {"sx", "sy", NULL};
+static const struct fast_parser OpenVG_vgScale_parser = {"scale", OpenVG_vgScale_keywords, 2, 2};
+
 static PyObject *
-OpenVG_vgScale(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgScale(PyVGContext *self, FAST_ARGS)
 {
-    VGfloat sx;
-    VGfloat sy;
-    const char *keywords[] = {"sx", "sy", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "ff", (char **) keywords, &sx, &sy)) {
+    PyObject *argv[2];
+    VGfloat sx, sy;
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgScale_parser, argv) ||
+        !fast_float(argv[0], &sx) ||
+        !fast_float(argv[1], &sy)) {
         return NULL;
     }
+
+    backend_wait();
     vgScale(sx, sy);
 
     Py_RETURN_NONE;
@@ -603,16 +1484,25 @@ PyDoc_STRVAR(OpenVG_vgTranslate__doc__,
 "   :type ty: float\n"
 );
 
+static const char *const OpenVG_vgTranslate_keywords[] = {"tx", "ty", NULL};
+static const struct fast_parser OpenVG_vgTranslate_parser = {"translate", OpenVG_vgTranslate_keywords, 2, 2};
+
 static PyObject *
-OpenVG_vgTranslate(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgTranslate(PyVGContext *self, FAST_ARGS)
 {
-    VGfloat tx;
-    VGfloat ty;
-    const char *keywords[] = {"tx", "ty", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "ff", (char **) keywords, &tx, &ty)) {
+    PyObject *argv[2];
+    VGfloat tx, ty;
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgTranslate_parser, argv) ||
+        !fast_float(argv[0], &tx) ||
+        !fast_float(argv[1], &ty)) {
         return NULL;
     }
+
+    backend_wait();
     vgTranslate(tx, ty);
 
     Py_RETURN_NONE;
@@ -640,18 +1530,35 @@ PyDoc_STRVAR(OpenVG_vgCopyPixels__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgCopyPixels, "VGContext.copy_pixels");
+
+static const char *const OpenVG_vgCopyPixels_keywords[] = {"dx", "dy", "sx", "sy", "width", "height", NULL};
+static const struct fast_parser OpenVG_vgCopyPixels_parser = {"copy_pixels", OpenVG_vgCopyPixels_keywords, 6, 6};
+
 static PyObject *
-OpenVG_vgCopyPixels(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgCopyPixels(PyVGContext *self, FAST_ARGS)
 {
+    PyObject *argv[6];
     VGint dx, dy, sx, sy, width, height;
 
-    const char *keywords[] = {"dx", "dy", "sx", "sy", "width", "height", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiiiii", (char **) keywords, &dx, &dy, &sx, &sy, &width, &height)) {
+    stats_scope stats(&stats_vgCopyPixels);
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgCopyPixels_parser, argv) ||
+        !fast_int(argv[0], &dx) ||
+        !fast_int(argv[1], &dy) ||
+        !fast_int(argv[2], &sx) ||
+        !fast_int(argv[3], &sy) ||
+        !fast_int(argv[4], &width) ||
+        !fast_int(argv[5], &height)) {
         return NULL;
     }
 
+    VG_BEGIN_ALLOW_THREADS
     vgCopyPixels(dx, dy, sx, sy, width, height);
+    VG_END_ALLOW_THREADS
 
     if (check_error()) {
         return NULL;
@@ -665,12 +1572,26 @@ PyDoc_STRVAR(OpenVG_vgFlush__doc__,
 ".. function:: flush()\n"
 "\n"
 "   Force outstanding requests to complete in finite time.\n"
+"\n"
+"   Reports any error held back while errors are deferred.\n"
 );
 
+STATS_ENTRY(stats_vgFlush, "VGContext.flush");
+
 static PyObject *
 OpenVG_vgFlush(PyVGContext *self, PyObject *args, PyObject *kwargs)
 {
+    stats_scope stats(&stats_vgFlush);
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    VG_BEGIN_ALLOW_THREADS
     vgFlush();
+    VG_END_ALLOW_THREADS
+
+    if (check_pending_error(false))
+        return NULL;
 
     Py_RETURN_NONE;
 }
@@ -699,18 +1620,39 @@ PyDoc_STRVAR(OpenVG_vgGetPixels__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgGetPixels, "VGContext.get_pixels");
+
+static const char *const OpenVG_vgGetPixels_keywords[] = {"dst", "dx", "dy", "sx", "sy", "width", "height", NULL};
+static const struct fast_parser OpenVG_vgGetPixels_parser = {"get_pixels", OpenVG_vgGetPixels_keywords, 7, 7};
+
 static PyObject *
-OpenVG_vgGetPixels(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgGetPixels(PyVGContext *self, FAST_ARGS)
 {
+    PyObject *argv[7];
     PyVGImage *dst;
     VGint dx, dy, sx, sy, width, height;
-    const char *keywords[] = {"dst", "dx", "dy", "sx", "sy", "width", "height", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!iiiiii", (char **) keywords, &PyVGImage_Type, &dst, &dx, &dy, &sx, &sy, &width, &height)) {
+
+    stats_scope stats(&stats_vgGetPixels);
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgGetPixels_parser, argv) ||
+        !fast_object(argv[0], &PyVGImage_Type, &dst) ||
+        !fast_int(argv[1], &dx) ||
+        !fast_int(argv[2], &dy) ||
+        !fast_int(argv[3], &sx) ||
+        !fast_int(argv[4], &sy) ||
+        !fast_int(argv[5], &width) ||
+        !fast_int(argv[6], &height)) {
         return NULL;
     }
 
+    stats.handle = dst->obj;
+
+    VG_BEGIN_ALLOW_THREADS
     vgGetPixels(dst->obj, dx, dy, sx, sy, width, height);
+    VG_END_ALLOW_THREADS
 
     if (check_error()) {
         return NULL;
@@ -731,16 +1673,22 @@ PyDoc_STRVAR(OpenVG_vgLoadMatrix__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+static const char *const OpenVG_vgLoadMatrix_keywords[] = {"matrix", NULL};
+static const struct fast_parser OpenVG_vgLoadMatrix_parser = {"load_matrix", OpenVG_vgLoadMatrix_keywords, 1, 1};
+
 static PyObject *
-OpenVG_vgLoadMatrix(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgLoadMatrix(PyVGContext *self, FAST_ARGS)
 {
+    PyObject *argv[1];
     VGfloat matrix[MATRIX_SIZE];
     PyObject *py_list;
     int idx;
 
-    const char *keywords[] = {"matrix", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!", (char **) keywords, &PyList_Type, &py_list)) {
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgLoadMatrix_parser, argv) ||
+        !fast_object(argv[0], &PyList_Type, &py_list)) {
         return NULL;
     }
     if (PyList_Size(py_list) != MATRIX_SIZE) {
@@ -756,6 +1704,7 @@ OpenVG_vgLoadMatrix(PyVGContext *self, PyObject *args, PyObject *kwargs)
         matrix[idx] = (float) PyFloat_AsDouble(element);
     }
 
+    backend_wait();
     vgLoadMatrix(matrix);
 
     if (check_error()) {
@@ -789,15 +1738,11 @@ OpenVG_vgResizeSurfaceSH(PyVGContext *self, PyObject *args, PyObject *kwargs)
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "ii", (char **) keywords, &width, &height)) {
         return NULL;
     }
-    vgResizeSurfaceSH(width, height);
 
-    if (check_error()) {
+    if (context_resize(self, width, height) < 0 || check_error()) {
         return NULL;
     }
 
-    self->dimensions[0] = width;
-    self->dimensions[1] = height;
-
     Py_RETURN_NONE;
 }
 
@@ -813,28 +1758,362 @@ PyDoc_STRVAR(OpenVG_vgShear__doc__,
 "   :type shy: float\n"
 );
 
+static const char *const OpenVG_vgShear_keywords[] = {"shx", "shy", NULL};
+static const struct fast_parser OpenVG_vgShear_parser = {"shear", OpenVG_vgShear_keywords, 2, 2};
+
 static PyObject *
-OpenVG_vgShear(PyVGContext *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgShear(PyVGContext *self, FAST_ARGS)
 {
-    VGfloat shx;
-    VGfloat shy;
-    const char *keywords[] = {"shx", "shy", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "ff", (char **) keywords, &shx, &shy)) {
+    PyObject *argv[2];
+    VGfloat shx, shy;
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgShear_parser, argv) ||
+        !fast_float(argv[0], &shx) ||
+        !fast_float(argv[1], &shy)) {
         return NULL;
     }
+
+    backend_wait();
     vgShear(shx, shy);
 
     Py_RETURN_NONE;
 }
 
 
+PyDoc_STRVAR(OpenVG_Check__doc__,
+".. function:: check()\n"
+"\n"
+"   Raise the first error since the last check, if any.\n"
+"\n"
+"   While errors are deferred, see VG.defer_errors(), the message gives\n"
+"   the range of wrapped calls that may have raised it.\n"
+);
+
+static PyObject *
+OpenVG_Check(PyVGContext *self)
+{
+    if (check_pending_error(true))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+PyDoc_STRVAR(OpenVG_Target__doc__,
+".. function:: target(image)\n"
+"\n"
+"   Return a context manager that makes `image' the drawing surface:\n"
+"\n"
+"      with context.target(image):\n"
+"          path.draw(VG_FILL_PATH)\n"
+"\n"
+"   Drawing starts from the contents of `image' and ends up in it when\n"
+"   the block is left.  Headless contexts draw into a surface of the\n"
+"   image size; GL contexts draw into the lower left corner of their\n"
+"   surface, scissored to the image and restored afterwards, so the\n"
+"   image may not be larger than the surface.  The context must be\n"
+"   current.  See VGRenderTarget for the cost and the nesting rules.\n"
+"\n"
+"   :arg image: The image to draw into.\n"
+"   :type image: VGImage\n"
+);
+
+static PyObject *
+OpenVG_Target(PyVGContext *self, PyObject *args, PyObject *kwargs)
+{
+    PyVGImage *image;
+    PyVGRenderTarget *target;
+
+    const char *keywords[] = {"image", NULL};
+    
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!", (char **) keywords, &PyVGImage_Type, &image)) {
+        return NULL;
+    }
+
+    target = PyObject_New(PyVGRenderTarget, &PyVGRenderTarget_Type);
+    if (target == NULL)
+        return NULL;
+
+    Py_INCREF(self);
+    target->context = self;
+    Py_INCREF(image);
+    target->image = image;
+    target->width = target->height = 0;
+    target->active = false;
+    target->pixels = target->previous = NULL;
+    target->saved = VG_INVALID_HANDLE;
+    target->scissor_rects = NULL;
+    target->num_scissor_rects = 0;
+
+    return (PyObject *)target;
+}
+
+
+PyDoc_STRVAR(OpenVG_ExecuteDisplayList__doc__,
+".. function:: execute(displayList)\n"
+"\n"
+"   Replay every command recorded in `displayList'.\n"
+"\n"
+"   Errors are checked once, after the last command, also while errors\n"
+"   are deferred.\n"
+"\n"
+"   :arg displayList: The recorded commands.\n"
+"   :type displayList: VGDisplayList\n"
+"\n"
+"   :error: VG_BAD_HANDLE_ERROR.\n"
+"   :error: VG_IMAGE_IN_USE_ERROR.\n"
+"   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
+);
+
+STATS_ENTRY(stats_ExecuteDisplayList, "VGContext.execute");
+
+static const char *const OpenVG_ExecuteDisplayList_keywords[] = {"displayList", NULL};
+static const struct fast_parser OpenVG_ExecuteDisplayList_parser = {"execute", OpenVG_ExecuteDisplayList_keywords, 1, 1};
+
+static PyObject *
+OpenVG_ExecuteDisplayList(PyVGContext *self, FAST_ARGS)
+{
+    PyObject *argv[1];
+    PyVGDisplayList *list;
+
+    stats_scope stats(&stats_ExecuteDisplayList);
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_ExecuteDisplayList_parser, argv) ||
+        !fast_object(argv[0], &PyVGDisplayList_Type, &list)) {
+        return NULL;
+    }
+
+    /* keeps the list from being recorded into without the GIL */
+    list->executing++;
+    VG_BEGIN_ALLOW_THREADS
+    display_list_replay(list);
+    VG_END_ALLOW_THREADS
+    list->executing--;
+
+    if (check_error() || check_pending_error(false))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+PyDoc_STRVAR(OpenVG_DrawPaths__doc__,
+".. function:: draw_paths(paths[, matrices[, paints]])\n"
+"\n"
+"   Draw every path in `paths' in one call.\n"
+"\n"
+"   Each path is drawn with the current path-user-to-surface matrix\n"
+"   multiplied by its entry in `matrices'; the matrix and matrix mode are\n"
+"   restored afterwards.  Errors are checked once, after the last draw.\n"
+"\n"
+"   :arg paths: The paths.\n"
+"   :type paths: sequence of VGPath\n"
+"   :arg matrices: 9 floats per path, row after row.\n"
+"   :type matrices: float32 buffer (array('f'), memoryview, ...) or None\n"
+"   :arg paints: Per path, a VGPaint set for the path's paint_modes, an int\n"
+"      of VGPaintMode bits to draw with, or None for the path's paint_modes.\n"
+"      A path drawn with no paint mode bits is skipped.\n"
+"   :type paints: sequence or None\n"
+"\n"
+"   :error: VG_BAD_HANDLE_ERROR.\n"
+"   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
+);
+
+STATS_ENTRY(stats_DrawPaths, "VGContext.draw_paths");
+
+static PyObject *
+OpenVG_DrawPaths(PyVGContext *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *py_paths, *py_matrices = Py_None, *py_paints = Py_None;
+    PyObject *paths = NULL, *paints = NULL;
+    Py_buffer view;
+    VGPath *handles = NULL;
+    VGPaint *paint_handles = NULL;
+    VGbitfield *modes = NULL;
+    const VGfloat *matrices = NULL;
+    Py_ssize_t idx, count;
+
+    const char *keywords[] = {"paths", "matrices", "paints", NULL};
+
+    stats_scope stats(&stats_DrawPaths);
+    
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O|OO", (char **) keywords, &py_paths, &py_matrices, &py_paints)) {
+        return NULL;
+    }
+
+    view.obj = NULL;
+
+    /* tuples hold the items alive while the GIL is released */
+    if ((paths = PySequence_Tuple(py_paths)) == NULL)
+        return NULL;
+    count = PyTuple_GET_SIZE(paths);
+
+    if (py_paints != Py_None) {
+        if ((paints = PySequence_Tuple(py_paints)) == NULL)
+            goto fail;
+        if (PyTuple_GET_SIZE(paints) != count) {
+            PyErr_Format(PyExc_ValueError,
+                         "VGContext.draw_paths(): %zd paints for %zd paths",
+                         PyTuple_GET_SIZE(paints), count);
+            goto fail;
+        }
+    }
+
+    if (py_matrices != Py_None) {
+        const char *format;
+
+        if (PyObject_GetBuffer(py_matrices, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+            goto fail;
+
+        format = view.format ? view.format : "B";
+        if (*format == '@' || *format == '=')
+            format++;
+        if (strcmp(format, "f") != 0) {
+            PyErr_SetString(PyExc_TypeError,
+                            "VGContext.draw_paths(): matrices must be a float32 buffer");
+            goto fail;
+        }
+        if (view.len != count * MATRIX_SIZE * (Py_ssize_t)sizeof(VGfloat)) {
+            PyErr_Format(PyExc_ValueError,
+                         "VGContext.draw_paths(): matrices holds %zd floats, %zd needed",
+                         view.len / (Py_ssize_t)sizeof(VGfloat), count * MATRIX_SIZE);
+            goto fail;
+        }
+        matrices = (const VGfloat *)view.buf;
+    }
+
+    handles = PyMem_New(VGPath, count);
+    paint_handles = PyMem_New(VGPaint, count);
+    modes = PyMem_New(VGbitfield, count);
+    if (count && (handles == NULL || paint_handles == NULL || modes == NULL)) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    for (idx = 0; idx < count; idx++) {
+        PyObject *path = PyTuple_GET_ITEM(paths, idx);
+        PyObject *paint = paints ? PyTuple_GET_ITEM(paints, idx) : Py_None;
+
+        if (!PyObject_TypeCheck(path, &PyVGPath_Type)) {
+            PyErr_Format(PyExc_TypeError,
+                         "VGContext.draw_paths(): paths[%zd] is not a VGPath", idx);
+            goto fail;
+        }
+        handles[idx] = ((PyVGPath *)path)->obj;
+        modes[idx] = ((PyVGPath *)path)->paint_modes;
+        paint_handles[idx] = VG_INVALID_HANDLE;
+
+        if (PyObject_TypeCheck(paint, &PyVGPaint_Type)) {
+            paint_handles[idx] = ((PyVGPaint *)paint)->obj;
+        }
+        else if (PyLong_Check(paint)) {
+            unsigned long bits = PyLong_AsUnsignedLong(paint);
+
+            if (PyErr_Occurred() || (bits & ~(unsigned long)(VG_STROKE_PATH | VG_FILL_PATH))) {
+                PyErr_Clear();
+                PyErr_SetString(PyExc_TypeError, "VG_ILLEGAL_ARGUMENT_ERROR");
+                goto fail;
+            }
+            modes[idx] = (VGbitfield)bits;
+        }
+        else if (paint != Py_None) {
+            PyErr_Format(PyExc_TypeError,
+                         "VGContext.draw_paths(): paints[%zd] must be a VGPaint, int or None", idx);
+            goto fail;
+        }
+    }
+
+    VG_BEGIN_ALLOW_THREADS
+    {
+        VGfloat base[MATRIX_SIZE];
+        VGint mode = vgGeti(VG_MATRIX_MODE);
+        VGPaint current = VG_INVALID_HANDLE;
+        VGbitfield current_modes = 0;
+
+        vgSeti(VG_MATRIX_MODE, VG_MATRIX_PATH_USER_TO_SURFACE);
+        vgGetMatrix(base);
+
+        for (idx = 0; idx < count; idx++) {
+            /* vgSetPaint and vgDrawPath reject an empty mode set */
+            if (modes[idx] == 0)
+                continue;
+            if (paint_handles[idx] != VG_INVALID_HANDLE &&
+                (paint_handles[idx] != current || modes[idx] != current_modes)) {
+                vgSetPaint(paint_handles[idx], modes[idx]);
+                current = paint_handles[idx];
+                current_modes = modes[idx];
+            }
+            if (matrices) {
+                vgLoadMatrix(base);
+                vgMultMatrix(matrices + idx * MATRIX_SIZE);
+            }
+            vgDrawPath(handles[idx], modes[idx]);
+        }
+
+        if (matrices)
+            vgLoadMatrix(base);
+        vgSeti(VG_MATRIX_MODE, mode);
+    }
+    VG_END_ALLOW_THREADS
+
+    PyMem_Free(modes);
+    PyMem_Free(paint_handles);
+    PyMem_Free(handles);
+    if (view.obj)
+        PyBuffer_Release(&view);
+    Py_XDECREF(paints);
+    Py_DECREF(paths);
+
+    if (check_error())
+        return NULL;
+
+    Py_RETURN_NONE;
+
+fail:
+    PyMem_Free(modes);
+    PyMem_Free(paint_handles);
+    PyMem_Free(handles);
+    if (view.obj)
+        PyBuffer_Release(&view);
+    Py_XDECREF(paints);
+    Py_XDECREF(paths);
+    return NULL;
+}
+
+
 static PyMethodDef PyVGContext_methods[] = {
+    {(char *) "check",
+     (PyCFunction) OpenVG_Check,
+     METH_NOARGS,
+     OpenVG_Check__doc__
+    },
     {(char *) "clear",
      (PyCFunction) OpenVG_vgClear,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgClear__doc__
     },
+    {(char *) "draw_paths",
+     (PyCFunction) OpenVG_DrawPaths,
+     METH_KEYWORDS|METH_VARARGS,
+     OpenVG_DrawPaths__doc__
+    },
+    {(char *) "execute",
+     (PyCFunction) OpenVG_ExecuteDisplayList,
+     METH_FAST,
+     OpenVG_ExecuteDisplayList__doc__
+    },
     {(char *) "flush",
      (PyCFunction) OpenVG_vgFlush,
      METH_NOARGS,
@@ -852,22 +2131,27 @@ static PyMethodDef PyVGContext_methods[] = {
     },
     {(char *) "rotate",
      (PyCFunction) OpenVG_vgRotate,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgRotate__doc__
     },
     {(char *) "scale",
      (PyCFunction) OpenVG_vgScale,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgScale__doc__
     },
     {(char *) "shear",
      (PyCFunction) OpenVG_vgShear,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgShear__doc__
     },
+    {(char *) "target",
+     (PyCFunction) OpenVG_Target,
+     METH_KEYWORDS|METH_VARARGS,
+     OpenVG_Target__doc__
+    },
     {(char *) "translate",
      (PyCFunction) OpenVG_vgTranslate,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgTranslate__doc__
     },
     {(char *) "get_matrix",
@@ -877,7 +2161,7 @@ static PyMethodDef PyVGContext_methods[] = {
     },
     {(char *) "load_matrix",
      (PyCFunction) OpenVG_vgLoadMatrix,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgLoadMatrix__doc__
     },
     {(char *) "load_identity",
@@ -887,27 +2171,27 @@ static PyMethodDef PyVGContext_methods[] = {
     },
     {(char *) "mult_matrix",
      (PyCFunction) OpenVG_vgMultMatrix,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgMultMatrix__doc__
     },
     {(char *) "mask",
      (PyCFunction) OpenVG_vgMask,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgMask__doc__
     },
     {(char *) "copy_pixels",
      (PyCFunction) OpenVG_vgCopyPixels,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgCopyPixels__doc__
     },
     {(char *) "get_pixels",
      (PyCFunction) OpenVG_vgGetPixels,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgGetPixels__doc__
     },
     {(char *) "set_pixels",
      (PyCFunction) OpenVG_vgSetPixels,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgSetPixels__doc__
     },
     {(char *) "read_pixels",
@@ -915,6 +2199,11 @@ static PyMethodDef PyVGContext_methods[] = {
      METH_KEYWORDS|METH_VARARGS,
      OpenVG_vgReadPixels__doc__
     },
+    {(char *) "read_pixels_into",
+     (PyCFunction) OpenVG_vgReadPixelsInto,
+     METH_KEYWORDS|METH_VARARGS,
+     OpenVG_vgReadPixelsInto__doc__
+    },
     {(char *) "write_pixels",
      (PyCFunction) OpenVG_vgWritePixels,
      METH_KEYWORDS|METH_VARARGS,
@@ -939,6 +2228,13 @@ PyVGContext__mp_subscript(PyVGContext *self, PyObject *value)
     PyObject *py_retval;
     VGuint key = PyLong_AsUnsignedLong(value);
     
+    if (key == (VGuint)-1 && PyErr_Occurred())
+        return NULL;
+
+    if (context_check_current(self) < 0)
+        return NULL;
+
+    backend_wait();
     switch (key) {
         case VG_STROKE_LINE_WIDTH:
         case VG_STROKE_MITER_LIMIT:
@@ -1012,7 +2308,7 @@ PyVGContext__mp_subscript(PyVGContext *self, PyObject *value)
             return NULL;
     }
 
-    return Py_BuildValue((char *) "N", py_retval);
+    return py_retval;
 }
 
 static int
@@ -1020,6 +2316,13 @@ PyVGContext__mp_ass_subscript(PyVGContext *self, PyObject *pykey, PyObject *valu
 {
     VGuint key = PyLong_AsUnsignedLong(pykey);
 
+    if (key == (VGuint)-1 && PyErr_Occurred())
+        return -1;
+
+    if (context_check_current(self) < 0)
+        return -1;
+
+    backend_wait();
     switch (key) {
         case VG_STROKE_LINE_WIDTH:
         case VG_STROKE_MITER_LIMIT:
@@ -1121,8 +2424,46 @@ static PyMappingMethods PyVGContext__tp_as_mapping = {
 static void
 PyVGContext__tp_dealloc(PyVGContext *self)
 {
-    if (self->init)
-        vgDestroyContextSH();
+    if (self->init) {
+        /* the next call loads the context of its thread afresh */
+        if (self == loaded_context || self == thread_context) {
+            loaded_context = thread_context = NULL;
+            backend_thread = 0;
+        }
+        if (self == default_context)
+            default_context = NULL;
+
+        if (--num_contexts == 0) {
+#ifdef HAVE_OSMESA
+            backend_wait();
+            if (share_context != NULL)
+                OSMesaMakeCurrent(share_context, share_pixel, GL_UNSIGNED_BYTE, 1, 1);
+#endif
+            vgDestroyContextSH();
+            context_clear_state(&default_state);
+        }
+    }
+
+#ifdef HAVE_OSMESA
+    if (self->headless) {
+        /* don't leave this thread bound to a destroyed context */
+        backend_wait();
+        if (OSMesaGetCurrentContext() == (OSMesaContext)self->headless) {
+            OSMesaMakeCurrent(share_context, share_pixel, GL_UNSIGNED_BYTE, 1, 1);
+            backend_thread = 0;
+        }
+        OSMesaDestroyContext((OSMesaContext)self->headless);
+    }
+    if (num_contexts == 0 && share_context != NULL) {
+        OSMesaDestroyContext(share_context);
+        share_context = NULL;
+    }
+#endif
+    if (self->state != NULL) {
+        context_clear_state(self->state);
+        PyMem_Free(self->state);
+    }
+    PyMem_Free(self->surface);
 
     Py_TYPE(self)->tp_free(self);
 
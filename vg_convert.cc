@@ -0,0 +1,686 @@
+/*
+ * Copyright (c) 2012 Dan Eicher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file COPYING;
+ * if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * Pixel format conversion between VGImageFormats.
+ *
+ * Rows are decoded into a canonical 32-bit word (R in bits 0-7, G 8-15,
+ * B 16-23, A 24-31), unpremultiplied / moved between sRGB and linear as
+ * needed, then encoded into the destination format.  Conversions that are
+ * a pure channel swizzle go straight from source to destination.
+ *
+ * The swizzle and premultiply kernels have SSE2, AVX2 and NEON versions;
+ * unpremultiply and the sRGB curves are table driven and stay scalar.
+ * Every kernel produces results identical to its scalar version.
+ *
+ * pixel_convert() touches no Python objects, so it runs without the GIL.
+ */
+
+#include "openvg_module.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+# define CONVERT_X86 1
+# include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+# define CONVERT_NEON 1
+# include <arm_neon.h>
+#endif
+
+/* layout bits of VGImageFormat */
+#define FORMAT_ALPHA_FIRST (1 << 6)
+#define FORMAT_BGR         (1 << 7)
+
+#define CHUNK 256
+
+enum { PIXEL_RGBA32, PIXEL_RGB565, PIXEL_L8, PIXEL_A8 };
+
+typedef struct {
+    int kind;
+    int shift[4];       /* bit offset of R, G, B, A within the pixel */
+    bool alpha;         /* false for the X and alpha-less formats */
+    bool linear;
+    bool premultiplied;
+} pixel_format;
+
+static const int canonical_shift[4] = {0, 8, 16, 24};
+
+static VGubyte srgb_to_linear8[256];
+static VGubyte linear_to_srgb8[256];
+static float srgb_to_linear_f[256];
+static VGubyte linear12_to_srgb8[4096];
+static VGuint unpremultiply_scale[256];
+
+
+static bool
+describe_format(VGImageFormat format, pixel_format *desc)
+{
+    int layout = format & (FORMAT_ALPHA_FIRST | FORMAT_BGR);
+    int base = format & ~(FORMAT_ALPHA_FIRST | FORMAT_BGR);
+
+    memset(desc, 0, sizeof(*desc));
+
+    switch (base) {
+        case VG_sRGBX_8888:
+        case VG_sRGBA_8888:
+        case VG_sRGBA_8888_PRE:
+        case VG_lRGBX_8888:
+        case VG_lRGBA_8888:
+        case VG_lRGBA_8888_PRE: {
+            static const int shifts[4][4] = {
+                {24, 16,  8,  0},   /* RGBA */
+                {16,  8,  0, 24},   /* ARGB */
+                { 8, 16, 24,  0},   /* BGRA */
+                { 0,  8, 16, 24},   /* ABGR */
+            };
+            int idx = (layout & FORMAT_ALPHA_FIRST ? 1 : 0) + (layout & FORMAT_BGR ? 2 : 0);
+
+            desc->kind = PIXEL_RGBA32;
+            memcpy(desc->shift, shifts[idx], sizeof(desc->shift));
+            desc->alpha = base != VG_sRGBX_8888 && base != VG_lRGBX_8888;
+            desc->linear = base >= VG_lRGBX_8888;
+            desc->premultiplied = base == VG_sRGBA_8888_PRE || base == VG_lRGBA_8888_PRE;
+            return true;
+        }
+        case VG_sRGB_565:
+            if (layout & FORMAT_ALPHA_FIRST)
+                return false;
+            desc->kind = PIXEL_RGB565;
+            desc->shift[0] = layout & FORMAT_BGR ? 0 : 11;
+            desc->shift[1] = 5;
+            desc->shift[2] = layout & FORMAT_BGR ? 11 : 0;
+            return true;
+        case VG_sL_8:
+        case VG_lL_8:
+            if (layout)
+                return false;
+            desc->kind = PIXEL_L8;
+            desc->linear = base == VG_lL_8;
+            return true;
+        case VG_A_8:
+            if (layout)
+                return false;
+            desc->kind = PIXEL_A8;
+            desc->alpha = true;
+            return true;
+    }
+    return false;
+}
+
+bool
+pixel_convert_supported(VGImageFormat format)
+{
+    pixel_format desc;
+
+    return describe_format(format, &desc);
+}
+
+static int
+pixel_bytes(const pixel_format *desc)
+{
+    switch (desc->kind) {
+        case PIXEL_RGBA32:
+            return 4;
+        case PIXEL_RGB565:
+            return 2;
+    }
+    return 1;
+}
+
+/* --- swizzle: dst byte lane `to[c]' = src byte lane `from[c]' --- */
+
+typedef struct {
+    int from[4];        /* source bit offsets of R, G, B, A */
+    int to[4];          /* destination bit offsets */
+    VGuint fill;        /* OR'd into every destination pixel */
+} swizzle;
+
+static void
+swizzle_scalar(const VGubyte *src, VGubyte *dst, int count, const swizzle *sw)
+{
+    int idx;
+
+    for (idx = 0; idx < count; idx++) {
+        VGuint in, out = sw->fill;
+
+        memcpy(&in, src + 4 * idx, 4);
+        out |= ((in >> sw->from[0]) & 0xff) << sw->to[0];
+        out |= ((in >> sw->from[1]) & 0xff) << sw->to[1];
+        out |= ((in >> sw->from[2]) & 0xff) << sw->to[2];
+        out |= ((in >> sw->from[3]) & 0xff) << sw->to[3];
+        memcpy(dst + 4 * idx, &out, 4);
+    }
+}
+
+#ifdef CONVERT_X86
+static void
+swizzle_sse2(const VGubyte *src, VGubyte *dst, int count, const swizzle *sw)
+{
+    const __m128i byte = _mm_set1_epi32(0xff);
+    const __m128i fill = _mm_set1_epi32((int)sw->fill);
+    __m128i from[4], to[4];
+    int idx, c;
+
+    for (c = 0; c < 4; c++) {
+        from[c] = _mm_cvtsi32_si128(sw->from[c]);
+        to[c] = _mm_cvtsi32_si128(sw->to[c]);
+    }
+
+    for (idx = 0; idx + 4 <= count; idx += 4) {
+        __m128i in = _mm_loadu_si128((const __m128i *)(src + 4 * idx));
+        __m128i out = fill;
+
+        for (c = 0; c < 4; c++) {
+            __m128i lane = _mm_and_si128(_mm_srl_epi32(in, from[c]), byte);
+            out = _mm_or_si128(out, _mm_sll_epi32(lane, to[c]));
+        }
+        _mm_storeu_si128((__m128i *)(dst + 4 * idx), out);
+    }
+    swizzle_scalar(src + 4 * idx, dst + 4 * idx, count - idx, sw);
+}
+
+__attribute__((target("avx2")))
+static void
+swizzle_avx2(const VGubyte *src, VGubyte *dst, int count, const swizzle *sw)
+{
+    char control[32];
+    __m256i shuffle, fill;
+    int idx, c;
+
+    /* x86 is little endian: bit offset / 8 is the byte within the pixel */
+    memset(control, 0x80, sizeof(control));
+    for (idx = 0; idx < 8; idx++) {
+        for (c = 0; c < 4; c++) {
+            control[(idx & 3) * 4 + sw->to[c] / 8 + (idx & 4) * 4] =
+                (char)((idx & 3) * 4 + sw->from[c] / 8);
+        }
+    }
+    shuffle = _mm256_loadu_si256((const __m256i *)control);
+    fill = _mm256_set1_epi32((int)sw->fill);
+
+    for (idx = 0; idx + 8 <= count; idx += 8) {
+        __m256i in = _mm256_loadu_si256((const __m256i *)(src + 4 * idx));
+        __m256i out = _mm256_or_si256(_mm256_shuffle_epi8(in, shuffle), fill);
+
+        _mm256_storeu_si256((__m256i *)(dst + 4 * idx), out);
+    }
+    swizzle_sse2(src + 4 * idx, dst + 4 * idx, count - idx, sw);
+}
+#endif
+
+#ifdef CONVERT_NEON
+static void
+swizzle_neon(const VGubyte *src, VGubyte *dst, int count, const swizzle *sw)
+{
+    int idx, c;
+
+    for (idx = 0; idx + 16 <= count; idx += 16) {
+        uint8x16x4_t in = vld4q_u8(src + 4 * idx);
+        uint8x16x4_t out;
+
+        for (c = 0; c < 4; c++) {
+            out.val[c] = vdupq_n_u8((VGubyte)(sw->fill >> (8 * c)));
+        }
+        for (c = 0; c < 4; c++) {
+            out.val[sw->to[c] / 8] = vorrq_u8(out.val[sw->to[c] / 8],
+                                              in.val[sw->from[c] / 8]);
+        }
+        vst4q_u8(dst + 4 * idx, out);
+    }
+    swizzle_scalar(src + 4 * idx, dst + 4 * idx, count - idx, sw);
+}
+#endif
+
+
+/* --- premultiply canonical pixels, c = round(c * a / 255) --- */
+
+static void
+premultiply_scalar(VGuint *pixels, int count)
+{
+    int idx, c;
+
+    for (idx = 0; idx < count; idx++) {
+        VGuint in = pixels[idx], a = in >> 24, out = in & 0xff000000;
+
+        for (c = 0; c < 24; c += 8) {
+            VGuint t = ((in >> c) & 0xff) * a + 128;
+            out |= ((t + (t >> 8)) >> 8) << c;
+        }
+        pixels[idx] = out;
+    }
+}
+
+#ifdef CONVERT_X86
+static inline __m128i
+premultiply_half_sse2(__m128i half)
+{
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(half, 0xff), 0xff);
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(half, alpha), _mm_set1_epi16(128));
+
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+static void
+premultiply_sse2(VGuint *pixels, int count)
+{
+    const __m128i amask = _mm_set1_epi32((int)0xff000000);
+    const __m128i zero = _mm_setzero_si128();
+    int idx;
+
+    for (idx = 0; idx + 4 <= count; idx += 4) {
+        __m128i in = _mm_loadu_si128((const __m128i *)(pixels + idx));
+        __m128i lo = premultiply_half_sse2(_mm_unpacklo_epi8(in, zero));
+        __m128i hi = premultiply_half_sse2(_mm_unpackhi_epi8(in, zero));
+        __m128i out = _mm_packus_epi16(lo, hi);
+
+        out = _mm_or_si128(_mm_andnot_si128(amask, out), _mm_and_si128(amask, in));
+        _mm_storeu_si128((__m128i *)(pixels + idx), out);
+    }
+    premultiply_scalar(pixels + idx, count - idx);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i
+premultiply_half_avx2(__m256i half)
+{
+    __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(half, 0xff), 0xff);
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(half, alpha), _mm256_set1_epi16(128));
+
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+__attribute__((target("avx2")))
+static void
+premultiply_avx2(VGuint *pixels, int count)
+{
+    const __m256i amask = _mm256_set1_epi32((int)0xff000000);
+    const __m256i zero = _mm256_setzero_si256();
+    int idx;
+
+    for (idx = 0; idx + 8 <= count; idx += 8) {
+        __m256i in = _mm256_loadu_si256((const __m256i *)(pixels + idx));
+        __m256i lo = premultiply_half_avx2(_mm256_unpacklo_epi8(in, zero));
+        __m256i hi = premultiply_half_avx2(_mm256_unpackhi_epi8(in, zero));
+        __m256i out = _mm256_packus_epi16(lo, hi);
+
+        out = _mm256_or_si256(_mm256_andnot_si256(amask, out), _mm256_and_si256(amask, in));
+        _mm256_storeu_si256((__m256i *)(pixels + idx), out);
+    }
+    premultiply_sse2(pixels + idx, count - idx);
+}
+#endif
+
+#ifdef CONVERT_NEON
+static inline uint8x16_t
+premultiply_channel_neon(uint8x16_t c, uint8x16_t a)
+{
+    uint16x8_t lo = vmlal_u8(vdupq_n_u16(128), vget_low_u8(c), vget_low_u8(a));
+    uint16x8_t hi = vmlal_u8(vdupq_n_u16(128), vget_high_u8(c), vget_high_u8(a));
+
+    return vcombine_u8(vshrn_n_u16(vsraq_n_u16(lo, lo, 8), 8),
+                       vshrn_n_u16(vsraq_n_u16(hi, hi, 8), 8));
+}
+
+static void
+premultiply_neon(VGuint *pixels, int count)
+{
+    int idx;
+
+    for (idx = 0; idx + 16 <= count; idx += 16) {
+        uint8x16x4_t px = vld4q_u8((const VGubyte *)(pixels + idx));
+
+        px.val[0] = premultiply_channel_neon(px.val[0], px.val[3]);
+        px.val[1] = premultiply_channel_neon(px.val[1], px.val[3]);
+        px.val[2] = premultiply_channel_neon(px.val[2], px.val[3]);
+        vst4q_u8((VGubyte *)(pixels + idx), px);
+    }
+    premultiply_scalar(pixels + idx, count - idx);
+}
+#endif
+
+
+/* --- table driven steps, scalar only --- */
+
+static void
+unpremultiply(VGuint *pixels, int count)
+{
+    int idx, c;
+
+    for (idx = 0; idx < count; idx++) {
+        VGuint in = pixels[idx], out = in & 0xff000000;
+        VGuint scale = unpremultiply_scale[in >> 24];
+
+        for (c = 0; c < 24; c += 8) {
+            VGuint v = (((in >> c) & 0xff) * scale + 0x8000) >> 16;
+            out |= (v > 255 ? 255 : v) << c;
+        }
+        pixels[idx] = out;
+    }
+}
+
+static void
+apply_curve(VGuint *pixels, int count, const VGubyte *table)
+{
+    int idx;
+
+    for (idx = 0; idx < count; idx++) {
+        VGuint in = pixels[idx];
+
+        pixels[idx] = (in & 0xff000000) |
+                      (VGuint)table[in & 0xff] |
+                      (VGuint)table[(in >> 8) & 0xff] << 8 |
+                      (VGuint)table[(in >> 16) & 0xff] << 16;
+    }
+}
+
+
+static void (*swizzle_kernel)(const VGubyte *, VGubyte *, int, const swizzle *) = swizzle_scalar;
+static void (*premultiply_kernel)(VGuint *, int) = premultiply_scalar;
+
+/* fill the tables and pick the kernels for this CPU, called once from initVG */
+void
+pixel_convert_init(void)
+{
+    int idx;
+
+    for (idx = 0; idx < 256; idx++) {
+        double c = idx / 255.0;
+        double lin = c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+        double srgb = c <= 0.0031308 ? c * 12.92 : 1.055 * pow(c, 1 / 2.4) - 0.055;
+
+        srgb_to_linear8[idx] = (VGubyte)(lin * 255.0 + 0.5);
+        linear_to_srgb8[idx] = (VGubyte)(srgb * 255.0 + 0.5);
+        srgb_to_linear_f[idx] = (float)lin;
+        unpremultiply_scale[idx] = idx ? ((255 << 16) + idx / 2) / idx : 0;
+    }
+
+    for (idx = 0; idx < 4096; idx++) {
+        double c = idx / 4095.0;
+        double srgb = c <= 0.0031308 ? c * 12.92 : 1.055 * pow(c, 1 / 2.4) - 0.055;
+
+        linear12_to_srgb8[idx] = (VGubyte)(srgb * 255.0 + 0.5);
+    }
+
+#if defined(CONVERT_X86)
+    swizzle_kernel = swizzle_sse2;
+    premultiply_kernel = premultiply_sse2;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        swizzle_kernel = swizzle_avx2;
+        premultiply_kernel = premultiply_avx2;
+    }
+#elif defined(CONVERT_NEON)
+    swizzle_kernel = swizzle_neon;
+    premultiply_kernel = premultiply_neon;
+#endif
+}
+
+
+/* --- format codecs --- */
+
+/*
+ * Build the swizzle moving pixels from `from' to `to' bit offsets.  When
+ * either side has no alpha the destination alpha lane is filled with 0xff
+ * instead; the alpha move is then pointed at the red lane, which is
+ * written anyway.
+ */
+static void
+make_swizzle(const int *from, bool from_alpha, const int *to, bool to_alpha,
+             swizzle *sw)
+{
+    memcpy(sw->from, from, sizeof(sw->from));
+    memcpy(sw->to, to, sizeof(sw->to));
+    sw->fill = 0;
+    if (!from_alpha || !to_alpha) {
+        sw->fill = 0xffu << to[3];
+        sw->from[3] = from[0];
+        sw->to[3] = to[0];
+    }
+}
+
+static void
+decode_row(const VGubyte *src, const pixel_format *desc, VGuint *pixels, int count)
+{
+    int idx;
+
+    switch (desc->kind) {
+        case PIXEL_RGBA32: {
+            swizzle sw;
+
+            make_swizzle(desc->shift, desc->alpha, canonical_shift, true, &sw);
+            swizzle_kernel(src, (VGubyte *)pixels, count, &sw);
+            break;
+        }
+        case PIXEL_RGB565:
+            for (idx = 0; idx < count; idx++) {
+                unsigned short in;
+                VGuint r, g, b;
+
+                memcpy(&in, src + 2 * idx, 2);
+                r = (in >> desc->shift[0]) & 0x1f;
+                g = (in >> desc->shift[1]) & 0x3f;
+                b = (in >> desc->shift[2]) & 0x1f;
+                pixels[idx] = 0xff000000 |
+                              ((r << 3) | (r >> 2)) |
+                              ((g << 2) | (g >> 4)) << 8 |
+                              ((b << 3) | (b >> 2)) << 16;
+            }
+            break;
+        case PIXEL_L8:
+            for (idx = 0; idx < count; idx++) {
+                pixels[idx] = 0xff000000 | src[idx] * 0x010101u;
+            }
+            break;
+        case PIXEL_A8:
+            for (idx = 0; idx < count; idx++) {
+                pixels[idx] = (VGuint)src[idx] << 24 | 0xffffff;
+            }
+            break;
+    }
+}
+
+static void
+encode_row(const VGuint *pixels, bool linear, const pixel_format *desc,
+           VGubyte *dst, int count)
+{
+    int idx;
+
+    switch (desc->kind) {
+        case PIXEL_RGBA32: {
+            swizzle sw;
+
+            make_swizzle(canonical_shift, true, desc->shift, desc->alpha, &sw);
+            swizzle_kernel((const VGubyte *)pixels, dst, count, &sw);
+            break;
+        }
+        case PIXEL_RGB565:
+            for (idx = 0; idx < count; idx++) {
+                VGuint in = pixels[idx];
+                unsigned short out = (unsigned short)(
+                    ((( in        & 0xff) * 31 + 127) / 255) << desc->shift[0] |
+                    ((((in >> 8)  & 0xff) * 63 + 127) / 255) << desc->shift[1] |
+                    ((((in >> 16) & 0xff) * 31 + 127) / 255) << desc->shift[2]);
+
+                memcpy(dst + 2 * idx, &out, 2);
+            }
+            break;
+        case PIXEL_L8:
+            for (idx = 0; idx < count; idx++) {
+                VGuint in = pixels[idx];
+                float r, g, b, lum;
+
+                if (linear) {
+                    r = (in & 0xff) / 255.0f;
+                    g = ((in >> 8) & 0xff) / 255.0f;
+                    b = ((in >> 16) & 0xff) / 255.0f;
+                }
+                else {
+                    r = srgb_to_linear_f[in & 0xff];
+                    g = srgb_to_linear_f[(in >> 8) & 0xff];
+                    b = srgb_to_linear_f[(in >> 16) & 0xff];
+                }
+                lum = 0.2126f * r + 0.7152f * g + 0.0722f * b;
+                if (lum > 1.0f)
+                    lum = 1.0f;
+
+                if (desc->linear)
+                    dst[idx] = (VGubyte)(lum * 255.0f + 0.5f);
+                else
+                    dst[idx] = linear12_to_srgb8[(int)(lum * 4095.0f + 0.5f)];
+            }
+            break;
+        case PIXEL_A8:
+            for (idx = 0; idx < count; idx++) {
+                dst[idx] = (VGubyte)(pixels[idx] >> 24);
+            }
+            break;
+    }
+}
+
+
+/*
+ * Convert a `width' x `height' block from `srcFormat' to `dstFormat'.
+ * Strides may be negative; `src' and `dst' point at the first row.
+ * Both formats must pass pixel_convert_supported().
+ */
+void
+pixel_convert(const void *src, VGint srcStride, VGImageFormat srcFormat,
+              void *dst, VGint dstStride, VGImageFormat dstFormat,
+              VGint width, VGint height)
+{
+    pixel_format in, out;
+    VGuint pixels[CHUNK];
+    int row, idx;
+
+    describe_format(srcFormat, &in);
+    describe_format(dstFormat, &out);
+
+    /*
+     * Channel order is all that changes: same colour space and either the
+     * same premultiplication or an opaque source, where it makes no odds.
+     */
+    if (in.kind == PIXEL_RGBA32 && out.kind == PIXEL_RGBA32 &&
+        in.linear == out.linear &&
+        (!in.alpha || in.premultiplied == out.premultiplied)) {
+        swizzle sw;
+
+        make_swizzle(in.shift, in.alpha, out.shift, out.alpha, &sw);
+        for (row = 0; row < height; row++) {
+            swizzle_kernel((const VGubyte *)src + (Py_ssize_t)row * srcStride,
+                           (VGubyte *)dst + (Py_ssize_t)row * dstStride,
+                           width, &sw);
+        }
+        return;
+    }
+
+    for (row = 0; row < height; row++) {
+        const VGubyte *s = (const VGubyte *)src + (Py_ssize_t)row * srcStride;
+        VGubyte *d = (VGubyte *)dst + (Py_ssize_t)row * dstStride;
+
+        for (idx = 0; idx < width; idx += CHUNK) {
+            int count = width - idx < CHUNK ? width - idx : CHUNK;
+            bool linear = in.linear, premultiplied = in.premultiplied;
+
+            decode_row(s + idx * pixel_bytes(&in), &in, pixels, count);
+
+            if (premultiplied && (!out.premultiplied || linear != out.linear)) {
+                unpremultiply(pixels, count);
+                premultiplied = false;
+            }
+            if (out.kind != PIXEL_L8 && out.kind != PIXEL_A8 && linear != out.linear) {
+                apply_curve(pixels, count, linear ? linear_to_srgb8 : srgb_to_linear8);
+                linear = out.linear;
+            }
+            if (out.premultiplied && !premultiplied) {
+                premultiply_kernel(pixels, count);
+            }
+
+            encode_row(pixels, linear, &out, d + idx * pixel_bytes(&out), count);
+        }
+    }
+}
+
+
+/*
+ * Staging for calls that take a `transferFormat': the backend reads or
+ * writes a tightly packed buffer in that format and the bindings convert
+ * between it and the caller's `dataFormat'.  `stage->data' stays NULL when
+ * no conversion is needed and the caller's buffer should be used as is.
+ */
+int
+pixel_stage_init(pixel_stage *stage, VGImageFormat dataFormat,
+                 VGint transferFormat, VGint width, VGint height)
+{
+    Py_ssize_t bytes, offset;
+
+    stage->data = NULL;
+    stage->format = (VGImageFormat)transferFormat;
+
+    if (transferFormat < 0 || transferFormat == dataFormat)
+        return 0;
+
+    if (!pixel_convert_supported(dataFormat) ||
+        !pixel_convert_supported(stage->format)) {
+        PyErr_SetString(PyExc_ValueError, "VG_UNSUPPORTED_IMAGE_FORMAT_ERROR");
+        return -1;
+    }
+
+    if ((bytes = pixel_data_size(0, stage->format, width, 1, &offset)) < 0)
+        return -1;
+
+    stage->stride = (VGint)bytes;
+    if ((stage->data = PyMem_Malloc(bytes * height)) == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+/* convert caller data into the stage ahead of a write */
+void
+pixel_stage_pack(pixel_stage *stage, const void *data, VGint dataStride,
+                 VGImageFormat dataFormat, VGint width, VGint height)
+{
+    Py_BEGIN_ALLOW_THREADS
+    pixel_convert(data, dataStride, dataFormat,
+                  stage->data, stage->stride, stage->format, width, height);
+    Py_END_ALLOW_THREADS
+}
+
+/* convert the stage into caller data after a read */
+void
+pixel_stage_unpack(pixel_stage *stage, void *data, VGint dataStride,
+                   VGImageFormat dataFormat, VGint width, VGint height)
+{
+    Py_BEGIN_ALLOW_THREADS
+    pixel_convert(stage->data, stage->stride, stage->format,
+                  data, dataStride, dataFormat, width, height);
+    Py_END_ALLOW_THREADS
+}
+
+void
+pixel_stage_free(pixel_stage *stage)
+{
+    PyMem_Free(stage->data);
+    stage->data = NULL;
+}
@@ -0,0 +1,846 @@
+/*
+ * Copyright (c) 2012 Dan Eicher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file COPYING;
+ * if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * VGDisplayList records context calls into a flat command array that
+ * VGContext.execute() replays in one go, without the GIL and with a single
+ * error check at the end.  Matrices and parameter vectors live in a
+ * separate value pool; the paths, paints and images a list refers to are
+ * kept alive in `handles'.
+ */
+
+#include "openvg_module.h"
+
+enum {
+    DL_CLEAR,
+    DL_LOAD_IDENTITY,
+    DL_LOAD_MATRIX,
+    DL_MULT_MATRIX,
+    DL_ROTATE,
+    DL_SCALE,
+    DL_SHEAR,
+    DL_TRANSLATE,
+    DL_SETI,
+    DL_SETF,
+    DL_SETIV,
+    DL_SETFV,
+    DL_SET_PAINT,
+    DL_DRAW_PATH,
+    DL_DRAW_IMAGE,
+};
+
+struct display_command {
+    VGuint op;
+    VGuint key;                 /* VGParamType or VGPaintMode bits */
+    VGHandle handle;
+    union {
+        VGfloat f[4];
+        VGint i[4];
+    } arg;
+    Py_ssize_t values;          /* offset into the value pool */
+};
+
+union display_value {
+    VGfloat f;
+    VGint i;
+};
+
+
+static struct display_command *
+display_list_push(PyVGDisplayList *self, VGuint op)
+{
+    struct display_command *cmd;
+
+    if (self->executing) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "VGDisplayList: cannot record while the list is executing");
+        return NULL;
+    }
+
+    if (self->num_commands == self->max_commands) {
+        Py_ssize_t size = self->max_commands ? self->max_commands * 2 : 64;
+        struct display_command *commands;
+
+        commands = PyMem_Resize(self->commands, struct display_command, size);
+        if (commands == NULL) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        self->commands = commands;
+        self->max_commands = size;
+    }
+
+    cmd = &self->commands[self->num_commands++];
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->op = op;
+    return cmd;
+}
+
+/* reserve `count' pool entries, returns their offset or -1 */
+static Py_ssize_t
+display_list_values(PyVGDisplayList *self, Py_ssize_t count)
+{
+    Py_ssize_t offset = self->num_values;
+
+    if (self->num_values + count > self->max_values) {
+        Py_ssize_t size = self->max_values ? self->max_values * 2 : 64;
+        union display_value *values;
+
+        while (size < self->num_values + count)
+            size *= 2;
+
+        values = PyMem_Resize(self->values, union display_value, size);
+        if (values == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->values = values;
+        self->max_values = size;
+    }
+
+    self->num_values += count;
+    return offset;
+}
+
+static int
+display_list_keep(PyVGDisplayList *self, PyObject *obj)
+{
+    if (self->handles == NULL && (self->handles = PySet_New(NULL)) == NULL)
+        return -1;
+
+    return PySet_Add(self->handles, obj);
+}
+
+/* Push a command using `obj', which the list keeps alive from then on. */
+static struct display_command *
+display_list_push_handle(PyVGDisplayList *self, VGuint op, PyObject *obj)
+{
+    struct display_command *cmd = display_list_push(self, op);
+
+    if (cmd != NULL && display_list_keep(self, obj) < 0) {
+        self->num_commands--;
+        return NULL;
+    }
+    return cmd;
+}
+
+static int
+display_list_matrix(PyVGDisplayList *self, VGuint op, PyObject *py_list)
+{
+    struct display_command *cmd;
+    Py_ssize_t offset;
+    int idx;
+
+    if (PyList_Size(py_list) != MATRIX_SIZE) {
+        PyErr_SetString(PyExc_TypeError, "Parameter `matrix' must be a list of 9 floats");
+        return -1;
+    }
+    for (idx = 0; idx < MATRIX_SIZE; idx++) {
+        if (!PyFloat_Check(PyList_GET_ITEM(py_list, idx))) {
+            PyErr_SetString(PyExc_TypeError, "Parameter `matrix' must be a list of 9 floats");
+            return -1;
+        }
+    }
+
+    if ((offset = display_list_values(self, MATRIX_SIZE)) < 0)
+        return -1;
+
+    if ((cmd = display_list_push(self, op)) == NULL) {
+        self->num_values -= MATRIX_SIZE;
+        return -1;
+    }
+
+    cmd->values = offset;
+    for (idx = 0; idx < MATRIX_SIZE; idx++) {
+        self->values[offset + idx].f = (float) PyFloat_AsDouble(PyList_GET_ITEM(py_list, idx));
+    }
+    return 0;
+}
+
+
+/*
+ * Replay every recorded command.  Runs without the GIL, the caller keeps
+ * `executing' raised so nothing is recorded meanwhile.
+ */
+void
+display_list_replay(PyVGDisplayList *self)
+{
+    Py_ssize_t idx;
+
+    for (idx = 0; idx < self->num_commands; idx++) {
+        const struct display_command *cmd = &self->commands[idx];
+        const union display_value *values = self->values + cmd->values;
+
+        switch (cmd->op) {
+            case DL_CLEAR:
+                vgClear(cmd->arg.i[0], cmd->arg.i[1], cmd->arg.i[2], cmd->arg.i[3]);
+                break;
+            case DL_LOAD_IDENTITY:
+                vgLoadIdentity();
+                break;
+            case DL_LOAD_MATRIX:
+                vgLoadMatrix(&values->f);
+                break;
+            case DL_MULT_MATRIX:
+                vgMultMatrix(&values->f);
+                break;
+            case DL_ROTATE:
+                vgRotate(cmd->arg.f[0]);
+                break;
+            case DL_SCALE:
+                vgScale(cmd->arg.f[0], cmd->arg.f[1]);
+                break;
+            case DL_SHEAR:
+                vgShear(cmd->arg.f[0], cmd->arg.f[1]);
+                break;
+            case DL_TRANSLATE:
+                vgTranslate(cmd->arg.f[0], cmd->arg.f[1]);
+                break;
+            case DL_SETI:
+                vgSeti((VGParamType)cmd->key, cmd->arg.i[0]);
+                break;
+            case DL_SETF:
+                vgSetf((VGParamType)cmd->key, cmd->arg.f[0]);
+                break;
+            case DL_SETIV:
+                vgSetiv((VGParamType)cmd->key, cmd->arg.i[0], &values->i);
+                break;
+            case DL_SETFV:
+                vgSetfv((VGParamType)cmd->key, cmd->arg.i[0], &values->f);
+                break;
+            case DL_SET_PAINT:
+                vgSetPaint((VGPaint)cmd->handle, cmd->key);
+                break;
+            case DL_DRAW_PATH:
+                vgDrawPath((VGPath)cmd->handle, cmd->key);
+                break;
+            case DL_DRAW_IMAGE:
+                vgDrawImage((VGImage)cmd->handle);
+                break;
+        }
+    }
+}
+
+
+PyDoc_STRVAR(PyVGDisplayList_paint_fill__doc__,
+".. attribute:: paint_fill\n"
+"\n"
+"   :type VGPaint: Record setting the paint fill VGPaint (write-only).\n"
+);
+
+PyDoc_STRVAR(PyVGDisplayList_paint_stroke__doc__,
+".. attribute:: paint_stroke\n"
+"\n"
+"   :type VGPaint: Record setting the paint stroke VGPaint (write-only).\n"
+);
+
+static int
+PyVGDisplayList__set_paint(PyVGDisplayList *self, PyObject *value, void *closure)
+{
+    struct display_command *cmd;
+
+    if (value == NULL || !PyObject_TypeCheck(value, &PyVGPaint_Type)) {
+        PyErr_SetString(PyExc_TypeError, "VGDisplayList: expected a VGPaint");
+        return -1;
+    }
+
+    if ((cmd = display_list_push_handle(self, DL_SET_PAINT, value)) == NULL)
+        return -1;
+
+    cmd->handle = ((PyVGPaint *)value)->obj;
+    cmd->key = (VGuint)(size_t)closure;
+    return 0;
+}
+
+static PyGetSetDef PyVGDisplayList__getsets[] = {
+    {
+        (char*) "paint_fill", /* attribute name */
+        (getter) NULL, /* C function to get the attribute */
+        (setter) PyVGDisplayList__set_paint, /* C function to set the attribute */
+        PyVGDisplayList_paint_fill__doc__, /* optional doc string */
+        (void *) VG_FILL_PATH /* optional additional data for getter and setter */
+    },
+    {
+        (char*) "paint_stroke", /* attribute name */
+        (getter) NULL, /* C function to get the attribute */
+        (setter) PyVGDisplayList__set_paint, /* C function to set the attribute */
+        PyVGDisplayList_paint_stroke__doc__, /* optional doc string */
+        (void *) VG_STROKE_PATH /* optional additional data for getter and setter */
+    },
+    { NULL, NULL, NULL, NULL, NULL }
+};
+
+static int
+PyVGDisplayList__tp_init(PyVGDisplayList *self, PyObject *args, PyObject *kwargs)
+{
+    const char *keywords[] = {NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "", (char **) keywords)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+
+PyDoc_STRVAR(PyVGDisplayList_clear__doc__,
+".. function:: clear(x, y, width, height)\n"
+"\n"
+"   Record filling region with the VG_CLEAR_COLOR color.\n"
+"\n"
+"   :arg x: Start position x.\n"
+"   :type x: int\n"
+"   :arg y: Start position y.\n"
+"   :type y: int\n"
+"   :arg width: Width of the sub-region.\n"
+"   :type width: int\n"
+"   :arg height: Height of the sub-region.\n"
+);
+
+static PyObject *
+PyVGDisplayList_clear(PyVGDisplayList *self, PyObject *args, PyObject *kwargs)
+{
+    struct display_command *cmd;
+    VGint x, y, width, height;
+
+    const char *keywords[] = {"x", "y", "width", "height", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiii", (char **) keywords, &x, &y, &width, &height)) {
+        return NULL;
+    }
+
+    if ((cmd = display_list_push(self, DL_CLEAR)) == NULL)
+        return NULL;
+
+    cmd->arg.i[0] = x;
+    cmd->arg.i[1] = y;
+    cmd->arg.i[2] = width;
+    cmd->arg.i[3] = height;
+
+    Py_RETURN_NONE;
+}
+
+
+PyDoc_STRVAR(PyVGDisplayList_load_identity__doc__,
+".. function:: load_identity()\n"
+"\n"
+"   Record setting the current matrix to identity matrix.\n"
+);
+
+static PyObject *
+PyVGDisplayList_load_identity(PyVGDisplayList *self)
+{
+    if (display_list_push(self, DL_LOAD_IDENTITY) == NULL)
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+PyDoc_STRVAR(PyVGDisplayList_load_matrix__doc__,
+".. function:: load_matrix(matrix)\n"
+"\n"
+"   Record loading `matrix' into the current matrix.\n"
+"\n"
+"   :arg matrix: The matrix.\n"
+"   :type matrix: list of 9 floats\n"
+);
+
+static PyObject *
+PyVGDisplayList_load_matrix(PyVGDisplayList *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *py_list;
+
+    const char *keywords[] = {"matrix", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!", (char **) keywords, &PyList_Type, &py_list)) {
+        return NULL;
+    }
+
+    if (display_list_matrix(self, DL_LOAD_MATRIX, py_list) < 0)
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+PyDoc_STRVAR(PyVGDisplayList_mult_matrix__doc__,
+".. function:: mult_matrix(matrix)\n"
+"\n"
+"   Record multiplying the current matrix by `matrix'.\n"
+"\n"
+"   :arg matrix: multiplication matrix.\n"
+"   :type matrix: list of 9 floats\n"
+);
+
+static PyObject *
+PyVGDisplayList_mult_matrix(PyVGDisplayList *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *py_list;
+
+    const char *keywords[] = {"matrix", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!", (char **) keywords, &PyList_Type, &py_list)) {
+        return NULL;
+    }
+
+    if (display_list_matrix(self, DL_MULT_MATRIX, py_list) < 0)
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+PyDoc_STRVAR(PyVGDisplayList_rotate__doc__,
+".. function:: rotate(angle)\n"
+"\n"
+"   Record rotating the current matrix.\n"
+"\n"
+"   :arg angle: angle in degrees to rotate.\n"
+"   :type angle: float\n"
+);
+
+static PyObject *
+PyVGDisplayList_rotate(PyVGDisplayList *self, PyObject *args, PyObject *kwargs)
+{
+    struct display_command *cmd;
+    VGfloat angle;
+
+    const char *keywords[] = {"angle", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "f", (char **) keywords, &angle)) {
+        return NULL;
+    }
+
+    if ((cmd = display_list_push(self, DL_ROTATE)) == NULL)
+        return NULL;
+
+    cmd->arg.f[0] = angle;
+
+    Py_RETURN_NONE;
+}
+
+
+/* scale, shear and translate all take a pair of floats */
+static PyObject *
+display_list_pair(PyVGDisplayList *self, PyObject *args, PyObject *kwargs,
+                  VGuint op, const char **keywords)
+{
+    struct display_command *cmd;
+    VGfloat x, y;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "ff", (char **) keywords, &x, &y)) {
+        return NULL;
+    }
+
+    if ((cmd = display_list_push(self, op)) == NULL)
+        return NULL;
+
+    cmd->arg.f[0] = x;
+    cmd->arg.f[1] = y;
+
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(PyVGDisplayList_scale__doc__,
+".. function:: scale(sx, sy)\n"
+"\n"
+"   Record scaling the current transform matrix.\n"
+"\n"
+"   :arg sx: x factor.\n"
+"   :type sx: float\n"
+"   :arg sy: y factor.\n"
+"   :type sy: float\n"
+);
+
+static PyObject *
+PyVGDisplayList_scale(PyVGDisplayList *self, PyObject *args, PyObject *kwargs)
+{
+    const char *keywords[] = {"sx", "sy", NULL};
+
+    return display_list_pair(self, args, kwargs, DL_SCALE, keywords);
+}
+
+PyDoc_STRVAR(PyVGDisplayList_shear__doc__,
+".. function:: shear(shx, shy)\n"
+"\n"
+"   Record shearing the current transform matrix.\n"
+"\n"
+"   :arg shx: x factor.\n"
+"   :type shx: float\n"
+"   :arg shy: y factor.\n"
+"   :type shy: float\n"
+);
+
+static PyObject *
+PyVGDisplayList_shear(PyVGDisplayList *self, PyObject *args, PyObject *kwargs)
+{
+    const char *keywords[] = {"shx", "shy", NULL};
+
+    return display_list_pair(self, args, kwargs, DL_SHEAR, keywords);
+}
+
+PyDoc_STRVAR(PyVGDisplayList_translate__doc__,
+".. function:: translate(tx, ty)\n"
+"\n"
+"   Record a translation of the current transform matrix.\n"
+"\n"
+"   :arg tx: x factor.\n"
+"   :type tx: float\n"
+"   :arg ty: y factor.\n"
+"   :type ty: float\n"
+);
+
+static PyObject *
+PyVGDisplayList_translate(PyVGDisplayList *self, PyObject *args, PyObject *kwargs)
+{
+    const char *keywords[] = {"tx", "ty", NULL};
+
+    return display_list_pair(self, args, kwargs, DL_TRANSLATE, keywords);
+}
+
+
+PyDoc_STRVAR(PyVGDisplayList_draw_path__doc__,
+".. function:: draw_path(path[, paintModes])\n"
+"\n"
+"   Record drawing `path'.\n"
+"\n"
+"   :arg path: The path.\n"
+"   :type path: VGPath\n"
+"   :arg paintModes: Paint modes, defaults to the path's current paint_modes.\n"
+"   :type paintModes: int\n"
+);
+
+static PyObject *
+PyVGDisplayList_draw_path(PyVGDisplayList *self, PyObject *args, PyObject *kwargs)
+{
+    struct display_command *cmd;
+    PyVGPath *path;
+    unsigned int modes = (unsigned int)-1;
+
+    const char *keywords[] = {"path", "paintModes", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!|I", (char **) keywords, &PyVGPath_Type, &path, &modes)) {
+        return NULL;
+    }
+
+    if (modes == (unsigned int)-1)
+        modes = path->paint_modes;
+    else if (modes & (~(VG_STROKE_PATH | VG_FILL_PATH))) {
+        PyErr_SetString(PyExc_TypeError, "VG_ILLEGAL_ARGUMENT_ERROR");
+        return NULL;
+    }
+
+    if ((cmd = display_list_push_handle(self, DL_DRAW_PATH, (PyObject *)path)) == NULL)
+        return NULL;
+
+    cmd->handle = path->obj;
+    cmd->key = modes;
+
+    Py_RETURN_NONE;
+}
+
+
+PyDoc_STRVAR(PyVGDisplayList_draw_image__doc__,
+".. function:: draw_image(image)\n"
+"\n"
+"   Record drawing `image' with the current image-user-to-surface matrix.\n"
+"\n"
+"   :arg image: The image.\n"
+"   :type image: VGImage\n"
+);
+
+static PyObject *
+PyVGDisplayList_draw_image(PyVGDisplayList *self, PyObject *args, PyObject *kwargs)
+{
+    struct display_command *cmd;
+    PyVGImage *image;
+
+    const char *keywords[] = {"image", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!", (char **) keywords, &PyVGImage_Type, &image)) {
+        return NULL;
+    }
+
+    if ((cmd = display_list_push_handle(self, DL_DRAW_IMAGE, (PyObject *)image)) == NULL)
+        return NULL;
+
+    cmd->handle = image->obj;
+
+    Py_RETURN_NONE;
+}
+
+
+PyDoc_STRVAR(PyVGDisplayList_reset__doc__,
+".. function:: reset()\n"
+"\n"
+"   Drop every recorded command.\n"
+);
+
+static PyObject *
+PyVGDisplayList_reset(PyVGDisplayList *self)
+{
+    if (self->executing) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "VGDisplayList: cannot record while the list is executing");
+        return NULL;
+    }
+
+    self->num_commands = 0;
+    self->num_values = 0;
+    if (self->handles)
+        PySet_Clear(self->handles);
+
+    Py_RETURN_NONE;
+}
+
+
+static PyMethodDef PyVGDisplayList_methods[] = {
+    {(char *) "clear",
+     (PyCFunction) PyVGDisplayList_clear,
+     METH_KEYWORDS|METH_VARARGS,
+     PyVGDisplayList_clear__doc__
+    },
+    {(char *) "draw_image",
+     (PyCFunction) PyVGDisplayList_draw_image,
+     METH_KEYWORDS|METH_VARARGS,
+     PyVGDisplayList_draw_image__doc__
+    },
+    {(char *) "draw_path",
+     (PyCFunction) PyVGDisplayList_draw_path,
+     METH_KEYWORDS|METH_VARARGS,
+     PyVGDisplayList_draw_path__doc__
+    },
+    {(char *) "load_identity",
+     (PyCFunction) PyVGDisplayList_load_identity,
+     METH_NOARGS,
+     PyVGDisplayList_load_identity__doc__
+    },
+    {(char *) "load_matrix",
+     (PyCFunction) PyVGDisplayList_load_matrix,
+     METH_KEYWORDS|METH_VARARGS,
+     PyVGDisplayList_load_matrix__doc__
+    },
+    {(char *) "mult_matrix",
+     (PyCFunction) PyVGDisplayList_mult_matrix,
+     METH_KEYWORDS|METH_VARARGS,
+     PyVGDisplayList_mult_matrix__doc__
+    },
+    {(char *) "reset",
+     (PyCFunction) PyVGDisplayList_reset,
+     METH_NOARGS,
+     PyVGDisplayList_reset__doc__
+    },
+    {(char *) "rotate",
+     (PyCFunction) PyVGDisplayList_rotate,
+     METH_KEYWORDS|METH_VARARGS,
+     PyVGDisplayList_rotate__doc__
+    },
+    {(char *) "scale",
+     (PyCFunction) PyVGDisplayList_scale,
+     METH_KEYWORDS|METH_VARARGS,
+     PyVGDisplayList_scale__doc__
+    },
+    {(char *) "shear",
+     (PyCFunction) PyVGDisplayList_shear,
+     METH_KEYWORDS|METH_VARARGS,
+     PyVGDisplayList_shear__doc__
+    },
+    {(char *) "translate",
+     (PyCFunction) PyVGDisplayList_translate,
+     METH_KEYWORDS|METH_VARARGS,
+     PyVGDisplayList_translate__doc__
+    },
+    {NULL, NULL, 0, NULL}
+};
+
+static Py_ssize_t
+PyVGDisplayList__mp_length(PyVGDisplayList *self)
+{
+    return self->num_commands;
+}
+
+/* record a context parameter, same keys and value types as VGContext[key] */
+static int
+PyVGDisplayList__mp_ass_subscript(PyVGDisplayList *self, PyObject *pykey, PyObject *value)
+{
+    struct display_command *cmd;
+    Py_ssize_t offset;
+    VGuint key = PyLong_AsUnsignedLong(pykey);
+
+    if (key == (VGuint)-1 && PyErr_Occurred())
+        return -1;
+
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError,
+                        "VGDisplayList[key]: recorded values cannot be deleted");
+        return -1;
+    }
+
+    switch (key) {
+        case VG_STROKE_LINE_WIDTH:
+        case VG_STROKE_MITER_LIMIT:
+        case VG_STROKE_DASH_PHASE: {
+            VGfloat tmp_value = (float) PyFloat_AsDouble(value);
+
+            if (PyErr_Occurred())
+                return -1;
+            if ((cmd = display_list_push(self, DL_SETF)) == NULL)
+                return -1;
+            cmd->arg.f[0] = tmp_value;
+            break;
+        }
+        case VG_SCISSOR_RECTS:
+        case VG_STROKE_DASH_PATTERN:
+        case VG_TILE_FILL_COLOR:
+        case VG_CLEAR_COLOR: {
+            bool ints = key == VG_SCISSOR_RECTS;
+            int idx, count;
+
+            if (PyList_Check(value) == 0) {
+                PyErr_SetString(PyExc_TypeError, ints ?
+                                "VGDisplayList[key]: expected a list of ints" :
+                                "VGDisplayList[key]: expected a list of floats");
+                return -1;
+            }
+
+            count = PyList_Size(value);
+            if ((offset = display_list_values(self, count)) < 0)
+                return -1;
+
+            for (idx = 0; idx < count; idx++) {
+                PyObject *py_tmp = PyList_GET_ITEM(value, idx);
+
+                if (ints)
+                    self->values[offset + idx].i = PyLong_AsLong(py_tmp);
+                else
+                    self->values[offset + idx].f = (float) PyFloat_AsDouble(py_tmp);
+            }
+
+            if (PyErr_Occurred() ||
+                (cmd = display_list_push(self, ints ? DL_SETIV : DL_SETFV)) == NULL) {
+                self->num_values -= count;
+                return -1;
+            }
+            cmd->arg.i[0] = count;
+            cmd->values = offset;
+            break;
+        }
+        case VG_MATRIX_MODE:
+        case VG_FILL_RULE:
+        case VG_IMAGE_QUALITY:
+        case VG_RENDERING_QUALITY:
+        case VG_BLEND_MODE:
+        case VG_IMAGE_MODE:
+        case VG_STROKE_CAP_STYLE:
+        case VG_STROKE_JOIN_STYLE:
+        case VG_STROKE_DASH_PHASE_RESET:
+        case VG_MASKING:
+        case VG_SCISSORING:
+        case VG_PIXEL_LAYOUT:
+        case VG_SCREEN_LAYOUT:
+        case VG_FILTER_FORMAT_LINEAR:
+        case VG_FILTER_FORMAT_PREMULTIPLIED:
+        case VG_FILTER_CHANNEL_MASK: {
+            VGint tmp_value = PyLong_AsLong(value);
+
+            if (PyErr_Occurred())
+                return -1;
+            if ((cmd = display_list_push(self, DL_SETI)) == NULL)
+                return -1;
+            cmd->arg.i[0] = tmp_value;
+            break;
+        }
+        default:
+            PyErr_SetString(PyExc_IndexError,
+                            "VGDisplayList[key]: key must be a writable VGParamType");
+            return -1;
+    }
+
+    cmd->key = key;
+    return 0;
+}
+
+static PyMappingMethods PyVGDisplayList__tp_as_mapping = {
+	(lenfunc) PyVGDisplayList__mp_length,	                /* mp_length */
+	(binaryfunc) NULL,	                                /* mp_subscript */
+	(objobjargproc) PyVGDisplayList__mp_ass_subscript,  /* mp_ass_subscript */
+};
+
+static void
+PyVGDisplayList__tp_dealloc(PyVGDisplayList *self)
+{
+    PyMem_Free(self->commands);
+    PyMem_Free(self->values);
+    Py_XDECREF(self->handles);
+
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+PyTypeObject PyVGDisplayList_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    (char *) "VG.VGDisplayList",               /* tp_name */
+    sizeof(PyVGDisplayList),                       /* tp_basicsize */
+    0,                                             /* tp_itemsize */
+    /* methods */
+    (destructor)PyVGDisplayList__tp_dealloc,       /* tp_dealloc */
+    (printfunc)0,                                  /* tp_print */
+    (getattrfunc)NULL,                             /* tp_getattr */
+    (setattrfunc)NULL,                             /* tp_setattr */
+    (cmpfunc)NULL,                                 /* tp_compare */
+    (reprfunc)NULL,                                /* tp_repr */
+    (PyNumberMethods*)NULL,                        /* tp_as_number */
+    (PySequenceMethods*)NULL,                      /* tp_as_sequence */
+    (PyMappingMethods*)&PyVGDisplayList__tp_as_mapping, /* tp_as_mapping */
+    (hashfunc)NULL,                                /* tp_hash */
+    (ternaryfunc)NULL,                             /* tp_call */
+    (reprfunc)NULL,                                /* tp_str */
+    (getattrofunc)NULL,                            /* tp_getattro */
+    (setattrofunc)NULL,                            /* tp_setattro */
+    (PyBufferProcs*)NULL,                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                            /* tp_flags */
+    NULL,                                          /* Documentation string */
+    (traverseproc)NULL,                            /* tp_traverse */
+    (inquiry)NULL,                                 /* tp_clear */
+    (richcmpfunc)NULL,                             /* tp_richcompare */
+    0,                                             /* tp_weaklistoffset */
+    (getiterfunc)NULL,                             /* tp_iter */
+    (iternextfunc)NULL,                            /* tp_iternext */
+    (struct PyMethodDef*)PyVGDisplayList_methods,  /* tp_methods */
+    (struct PyMemberDef*)0,                        /* tp_members */
+    PyVGDisplayList__getsets,                      /* tp_getset */
+    NULL,                                          /* tp_base */
+    NULL,                                          /* tp_dict */
+    (descrgetfunc)NULL,                            /* tp_descr_get */
+    (descrsetfunc)NULL,                            /* tp_descr_set */
+    0,                                             /* tp_dictoffset */
+    (initproc)PyVGDisplayList__tp_init,            /* tp_init */
+    (allocfunc)PyType_GenericAlloc,                /* tp_alloc */
+    (newfunc)PyType_GenericNew,                    /* tp_new */
+    (freefunc)0,                                   /* tp_free */
+    (inquiry)NULL,                                 /* tp_is_gc */
+    NULL,                                          /* tp_bases */
+    NULL,                                          /* tp_mro */
+    NULL,                                          /* tp_cache */
+    NULL,                                          /* tp_subclasses */
+    NULL,                                          /* tp_weaklist */
+    (destructor) NULL                              /* tp_del */
+};
+
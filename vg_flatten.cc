@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2012 Dan Eicher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file COPYING;
+ * if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * Tessellation cache of VGPath.  The recorded segments and coordinates of
+ * a path are flattened into a path of absolute lines, which the backend
+ * draws without subdividing any curves.  The flattened copy is made for
+ * the current path-user-to-surface scale times tessellation_band, so it
+ * stays within tolerance until the scale grows past that, and is redone
+ * once the scale leaves the band either way.
+ */
+
+#include "openvg_module.h"
+#include <math.h>
+
+#define FLATTEN_MAX_STEPS 1024
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+struct flat_builder {
+    VGubyte *segments;
+    VGint num_segments;
+    VGint max_segments;
+    VGfloat *coords;
+    VGint num_coords;
+    VGint max_coords;
+    bool failed;
+};
+
+
+static void
+flat_push(struct flat_builder *b, VGubyte segment, VGfloat x, VGfloat y)
+{
+    VGint coords = segment == VG_CLOSE_PATH ? 0 : 2;
+
+    if (b->failed)
+        return;
+
+    if (b->num_segments == b->max_segments) {
+        VGint max = b->max_segments ? b->max_segments * 2 : 64;
+        VGubyte *tmp = b->segments;
+
+        if (PyMem_Resize(tmp, VGubyte, max) == NULL) {
+            b->failed = true;
+            return;
+        }
+        b->segments = tmp;
+        b->max_segments = max;
+    }
+    if (b->num_coords + coords > b->max_coords) {
+        VGint max = b->max_coords ? b->max_coords * 2 : 128;
+        VGfloat *tmp = b->coords;
+
+        if (PyMem_Resize(tmp, VGfloat, max) == NULL) {
+            b->failed = true;
+            return;
+        }
+        b->coords = tmp;
+        b->max_coords = max;
+    }
+
+    b->segments[b->num_segments++] = segment;
+    if (coords) {
+        b->coords[b->num_coords++] = x;
+        b->coords[b->num_coords++] = y;
+    }
+}
+
+/* Steps keeping a curve with second difference `dd' within `tolerance'. */
+static int
+flat_steps(VGfloat dd, VGfloat tolerance)
+{
+    VGfloat steps = ceilf(sqrtf(dd / (8.0f * tolerance)));
+
+    if (!(steps >= 1.0f))
+        return 1;
+    return steps > FLATTEN_MAX_STEPS ? FLATTEN_MAX_STEPS : (int)steps;
+}
+
+static void
+flat_quad(struct flat_builder *b, const VGfloat *p, VGfloat tolerance)
+{
+    VGfloat ddx = p[0] - 2.0f * p[2] + p[4];
+    VGfloat ddy = p[1] - 2.0f * p[3] + p[5];
+    int idx, steps = flat_steps(2.0f * sqrtf(ddx * ddx + ddy * ddy), tolerance);
+
+    for (idx = 1; idx < steps; idx++) {
+        VGfloat t = (VGfloat)idx / steps, u = 1.0f - t;
+
+        flat_push(b, VG_LINE_TO_ABS,
+                  u * u * p[0] + 2.0f * u * t * p[2] + t * t * p[4],
+                  u * u * p[1] + 2.0f * u * t * p[3] + t * t * p[5]);
+    }
+    flat_push(b, VG_LINE_TO_ABS, p[4], p[5]);
+}
+
+static void
+flat_cubic(struct flat_builder *b, const VGfloat *p, VGfloat tolerance)
+{
+    VGfloat ddx1 = p[0] - 2.0f * p[2] + p[4], ddy1 = p[1] - 2.0f * p[3] + p[5];
+    VGfloat ddx2 = p[2] - 2.0f * p[4] + p[6], ddy2 = p[3] - 2.0f * p[5] + p[7];
+    VGfloat dd = fmaxf(sqrtf(ddx1 * ddx1 + ddy1 * ddy1), sqrtf(ddx2 * ddx2 + ddy2 * ddy2));
+    int idx, steps = flat_steps(6.0f * dd, tolerance);
+
+    for (idx = 1; idx < steps; idx++) {
+        VGfloat t = (VGfloat)idx / steps, u = 1.0f - t;
+        VGfloat a = u * u * u, c1 = 3.0f * u * u * t, c2 = 3.0f * u * t * t, d = t * t * t;
+
+        flat_push(b, VG_LINE_TO_ABS,
+                  a * p[0] + c1 * p[2] + c2 * p[4] + d * p[6],
+                  a * p[1] + c1 * p[3] + c2 * p[5] + d * p[7]);
+    }
+    flat_push(b, VG_LINE_TO_ABS, p[6], p[7]);
+}
+
+static VGfloat
+flat_angle(VGfloat ux, VGfloat uy, VGfloat vx, VGfloat vy)
+{
+    return atan2f(ux * vy - uy * vx, ux * vx + uy * vy);
+}
+
+/* Elliptical arc from (x0, y0), endpoint to center parametrization. */
+static void
+flat_arc(struct flat_builder *b, VGfloat x0, VGfloat y0, VGfloat rx, VGfloat ry,
+         VGfloat rotation, VGfloat x1, VGfloat y1, bool large, bool ccw,
+         VGfloat tolerance)
+{
+    VGfloat phi = rotation * (VGfloat)M_PI / 180.0f;
+    VGfloat cp = cosf(phi), sp = sinf(phi);
+    VGfloat dx = (x0 - x1) / 2.0f, dy = (y0 - y1) / 2.0f;
+    VGfloat x0p = cp * dx + sp * dy, y0p = -sp * dx + cp * dy;
+    VGfloat lambda, num, den, coef, cxp, cyp, cx, cy, theta, dtheta, step;
+    int idx, steps;
+
+    rx = fabsf(rx);
+    ry = fabsf(ry);
+
+    if (rx == 0.0f || ry == 0.0f || (x0 == x1 && y0 == y1)) {
+        flat_push(b, VG_LINE_TO_ABS, x1, y1);
+        return;
+    }
+
+    lambda = (x0p * x0p) / (rx * rx) + (y0p * y0p) / (ry * ry);
+    if (lambda > 1.0f) {
+        rx *= sqrtf(lambda);
+        ry *= sqrtf(lambda);
+    }
+
+    num = rx * rx * ry * ry - rx * rx * y0p * y0p - ry * ry * x0p * x0p;
+    den = rx * rx * y0p * y0p + ry * ry * x0p * x0p;
+    coef = den > 0.0f && num > 0.0f ? sqrtf(num / den) : 0.0f;
+    if (large == ccw)
+        coef = -coef;
+
+    cxp = coef * rx * y0p / ry;
+    cyp = -coef * ry * x0p / rx;
+    cx = cp * cxp - sp * cyp + (x0 + x1) / 2.0f;
+    cy = sp * cxp + cp * cyp + (y0 + y1) / 2.0f;
+
+    theta = flat_angle(1.0f, 0.0f, (x0p - cxp) / rx, (y0p - cyp) / ry);
+    dtheta = flat_angle((x0p - cxp) / rx, (y0p - cyp) / ry,
+                        (-x0p - cxp) / rx, (-y0p - cyp) / ry);
+    if (!ccw && dtheta > 0.0f)
+        dtheta -= 2.0f * (VGfloat)M_PI;
+    else if (ccw && dtheta < 0.0f)
+        dtheta += 2.0f * (VGfloat)M_PI;
+
+    step = tolerance < fmaxf(rx, ry) ?
+           2.0f * acosf(1.0f - tolerance / fmaxf(rx, ry)) : (VGfloat)M_PI / 2.0f;
+    steps = (int)ceilf(fabsf(dtheta) / step);
+    if (steps < 1)
+        steps = 1;
+    else if (steps > FLATTEN_MAX_STEPS)
+        steps = FLATTEN_MAX_STEPS;
+
+    for (idx = 1; idx < steps; idx++) {
+        VGfloat t = theta + dtheta * idx / steps;
+        VGfloat ct = cosf(t), st = sinf(t);
+
+        flat_push(b, VG_LINE_TO_ABS,
+                  cx + rx * ct * cp - ry * st * sp,
+                  cy + rx * ct * sp + ry * st * cp);
+    }
+    flat_push(b, VG_LINE_TO_ABS, x1, y1);
+}
+
+/*
+ * A new path of absolute lines within `tolerance' user units of `path',
+ * or VG_INVALID_HANDLE.  The coordinates of `path' must be known.
+ */
+VGPath
+path_flatten(PyVGPath *path, VGfloat tolerance)
+{
+    struct flat_builder b = {NULL, 0, 0, NULL, 0, 0, false};
+    VGfloat *user = NULL;
+    const VGfloat *coords = (const VGfloat *)path->data;
+    VGfloat sx = 0, sy = 0, px = 0, py = 0;     /* subpath start, current */
+    VGfloat cx = 0, cy = 0;                     /* last control point */
+    VGubyte last = VG_CLOSE_PATH;
+    VGPath flat = VG_INVALID_HANDLE;
+    VGint idx;
+
+    /* the recorded coordinates are in the path's datatype */
+    if (path->datatype != VG_PATH_DATATYPE_F || path->scale != 1.0f || path->bias != 0.0f) {
+        user = PyMem_New(VGfloat, path->num_coords ? path->num_coords : 1);
+        if (user == NULL)
+            return VG_INVALID_HANDLE;
+        path_data_to_user(path->data, path->datatype, path->scale, path->bias,
+                          user, path->num_coords);
+        coords = user;
+    }
+
+    for (idx = 0; idx < path->num_segments && !b.failed; idx++) {
+        VGubyte segment = path->segments[idx] & ~VG_RELATIVE;
+        VGfloat ox = 0, oy = 0, p[8];
+
+        if (path->segments[idx] & VG_RELATIVE) {
+            ox = px;
+            oy = py;
+        }
+
+        switch (segment) {
+            case VG_CLOSE_PATH:
+                flat_push(&b, VG_CLOSE_PATH, 0, 0);
+                px = sx;
+                py = sy;
+                break;
+            case VG_MOVE_TO:
+                px = sx = coords[0] + ox;
+                py = sy = coords[1] + oy;
+                flat_push(&b, VG_MOVE_TO_ABS, px, py);
+                break;
+            case VG_LINE_TO:
+                px = coords[0] + ox;
+                py = coords[1] + oy;
+                flat_push(&b, VG_LINE_TO_ABS, px, py);
+                break;
+            case VG_HLINE_TO:
+                px = coords[0] + ox;
+                flat_push(&b, VG_LINE_TO_ABS, px, py);
+                break;
+            case VG_VLINE_TO:
+                py = coords[0] + oy;
+                flat_push(&b, VG_LINE_TO_ABS, px, py);
+                break;
+            case VG_QUAD_TO:
+            case VG_SQUAD_TO:
+                p[0] = px;
+                p[1] = py;
+                if (segment == VG_QUAD_TO) {
+                    p[2] = coords[0] + ox;
+                    p[3] = coords[1] + oy;
+                    p[4] = coords[2] + ox;
+                    p[5] = coords[3] + oy;
+                }
+                else {
+                    /* reflect the control point of a previous quad */
+                    p[2] = last == VG_QUAD_TO ? 2.0f * px - cx : px;
+                    p[3] = last == VG_QUAD_TO ? 2.0f * py - cy : py;
+                    p[4] = coords[0] + ox;
+                    p[5] = coords[1] + oy;
+                }
+                flat_quad(&b, p, tolerance);
+                cx = p[2];
+                cy = p[3];
+                px = p[4];
+                py = p[5];
+                break;
+            case VG_CUBIC_TO:
+            case VG_SCUBIC_TO:
+                p[0] = px;
+                p[1] = py;
+                if (segment == VG_CUBIC_TO) {
+                    p[2] = coords[0] + ox;
+                    p[3] = coords[1] + oy;
+                }
+                else {
+                    /* reflect the second control point of a previous cubic */
+                    p[2] = last == VG_CUBIC_TO ? 2.0f * px - cx : px;
+                    p[3] = last == VG_CUBIC_TO ? 2.0f * py - cy : py;
+                }
+                {
+                    const VGfloat *end = segment == VG_CUBIC_TO ? coords + 2 : coords;
+
+                    p[4] = end[0] + ox;
+                    p[5] = end[1] + oy;
+                    p[6] = end[2] + ox;
+                    p[7] = end[3] + oy;
+                }
+                flat_cubic(&b, p, tolerance);
+                cx = p[4];
+                cy = p[5];
+                px = p[6];
+                py = p[7];
+                break;
+            case VG_SCCWARC_TO:
+            case VG_SCWARC_TO:
+            case VG_LCCWARC_TO:
+            case VG_LCWARC_TO:
+                flat_arc(&b, px, py, coords[0], coords[1], coords[2],
+                         coords[3] + ox, coords[4] + oy,
+                         segment == VG_LCCWARC_TO || segment == VG_LCWARC_TO,
+                         segment == VG_SCCWARC_TO || segment == VG_LCCWARC_TO,
+                         tolerance);
+                px = coords[3] + ox;
+                py = coords[4] + oy;
+                break;
+        }
+
+        /* smooth segments continue the kind of curve they reflect */
+        last = segment == VG_SQUAD_TO ? VG_QUAD_TO :
+               segment == VG_SCUBIC_TO ? VG_CUBIC_TO : segment;
+        coords += path_segment_coords(path->segments[idx]);
+    }
+
+    if (!b.failed) {
+        backend_wait();
+        flat = vgCreatePath(VG_PATH_FORMAT_STANDARD, VG_PATH_DATATYPE_F, 1.0f, 0.0f,
+                            b.num_segments, b.num_coords, VG_PATH_CAPABILITY_APPEND_TO);
+        if (flat != VG_INVALID_HANDLE && b.num_segments)
+            vgAppendPathData(flat, b.num_segments, b.segments, b.coords);
+    }
+
+    PyMem_Free(b.segments);
+    PyMem_Free(b.coords);
+    PyMem_Free(user);
+    return flat;
+}
+
+/* The handle draw() should use for `path' under the current matrix. */
+VGPath
+path_tessellation(PyVGPath *path)
+{
+    VGfloat matrix[MATRIX_SIZE], scale;
+    VGint mode;
+
+    if (path->flat_tolerance <= 0.0f || !path_coords_known(path))
+        return path->obj;
+
+    backend_wait();
+    mode = vgGeti(VG_MATRIX_MODE);
+    if (mode != VG_MATRIX_PATH_USER_TO_SURFACE)
+        vgSeti(VG_MATRIX_MODE, VG_MATRIX_PATH_USER_TO_SURFACE);
+    vgGetMatrix(matrix);
+    if (mode != VG_MATRIX_PATH_USER_TO_SURFACE)
+        vgSeti(VG_MATRIX_MODE, mode);
+
+    /* the longer of the transformed unit vectors */
+    scale = sqrtf(fmaxf(matrix[0] * matrix[0] + matrix[1] * matrix[1],
+                        matrix[3] * matrix[3] + matrix[4] * matrix[4]));
+
+    if (path->flat != VG_INVALID_HANDLE &&
+        scale >= path->flat_scale[0] && scale <= path->flat_scale[1]) {
+        return path->flat;
+    }
+
+    path_invalidate_tessellation(path);
+
+    if (!(scale > 0.0f))
+        return path->obj;
+
+    path->flat = path_flatten(path, path->flat_tolerance / (scale * path->flat_band));
+    if (path->flat == VG_INVALID_HANDLE)
+        return path->obj;
+
+    path->flat_scale[0] = scale / path->flat_band;
+    path->flat_scale[1] = scale * path->flat_band;
+    return path->flat;
+}
+
+void
+path_invalidate_tessellation(PyVGPath *path)
+{
+    if (path->flat != VG_INVALID_HANDLE) {
+        backend_wait();
+        vgDestroyPath(path->flat);
+        path->flat = VG_INVALID_HANDLE;
+    }
+}
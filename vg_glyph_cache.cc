@@ -0,0 +1,694 @@
+/*
+ * Copyright (c) 2012 Dan Eicher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file COPYING;
+ * if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * VGGlyphCache maps (font, glyph) pairs to VGPaths.  Entries live in an
+ * array threaded on a least-recently-used list and are found through an
+ * open addressing table of entry indices.  The byte size of an entry is
+ * the storage of its path data; once the total exceeds the budget the
+ * least recently used entries are dropped.
+ */
+
+#include "openvg_module.h"
+
+#define SLOT_EMPTY      -1
+#define SLOT_DELETED    -2
+
+struct glyph_entry {
+    VGint font;
+    VGint glyph;
+    PyVGPath *path;             /* NULL while on the free list */
+    Py_ssize_t bytes;
+    Py_ssize_t prev, next;      /* LRU list, or free list through next */
+};
+
+
+static Py_ssize_t
+glyph_hash(VGint font, VGint glyph)
+{
+    unsigned long long key = ((unsigned long long)(VGuint)font << 32) | (VGuint)glyph;
+
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (Py_ssize_t)(key & PY_SSIZE_T_MAX);
+}
+
+/* Table slot holding (font, glyph), or -1. */
+static Py_ssize_t
+glyph_cache_find(PyVGGlyphCache *self, VGint font, VGint glyph)
+{
+    Py_ssize_t mask = self->table_size - 1;
+    Py_ssize_t slot;
+
+    if (self->table_size == 0)
+        return -1;
+
+    for (slot = glyph_hash(font, glyph) & mask; self->table[slot] != SLOT_EMPTY; slot = (slot + 1) & mask) {
+        Py_ssize_t idx = self->table[slot];
+
+        if (idx >= 0 && self->entries[idx].font == font && self->entries[idx].glyph == glyph)
+            return slot;
+    }
+    return -1;
+}
+
+/* Rebuild the table with room for `count' entries, dropping tombstones. */
+static int
+glyph_cache_rehash(PyVGGlyphCache *self, Py_ssize_t count)
+{
+    Py_ssize_t size = 16, idx, *table;
+
+    while (size / 4 * 3 <= count)
+        size *= 2;
+
+    table = PyMem_New(Py_ssize_t, size);
+    if (table == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (idx = 0; idx < size; idx++)
+        table[idx] = SLOT_EMPTY;
+
+    for (idx = 0; idx < self->num_entries; idx++) {
+        struct glyph_entry *entry = &self->entries[idx];
+        Py_ssize_t slot;
+
+        if (entry->path == NULL)
+            continue;
+        for (slot = glyph_hash(entry->font, entry->glyph) & (size - 1);
+             table[slot] != SLOT_EMPTY; slot = (slot + 1) & (size - 1))
+            ;
+        table[slot] = idx;
+    }
+
+    PyMem_Free(self->table);
+    self->table = table;
+    self->table_size = size;
+    self->table_used = self->count;
+    return 0;
+}
+
+static void
+glyph_cache_unlink(PyVGGlyphCache *self, Py_ssize_t idx)
+{
+    struct glyph_entry *entry = &self->entries[idx];
+
+    if (entry->prev >= 0)
+        self->entries[entry->prev].next = entry->next;
+    else
+        self->head = entry->next;
+    if (entry->next >= 0)
+        self->entries[entry->next].prev = entry->prev;
+    else
+        self->tail = entry->prev;
+}
+
+static void
+glyph_cache_push_front(PyVGGlyphCache *self, Py_ssize_t idx)
+{
+    struct glyph_entry *entry = &self->entries[idx];
+
+    entry->prev = -1;
+    entry->next = self->head;
+    if (self->head >= 0)
+        self->entries[self->head].prev = idx;
+    else
+        self->tail = idx;
+    self->head = idx;
+}
+
+static void
+glyph_cache_touch(PyVGGlyphCache *self, Py_ssize_t idx)
+{
+    if (self->head != idx) {
+        glyph_cache_unlink(self, idx);
+        glyph_cache_push_front(self, idx);
+    }
+}
+
+/* Drop the entry in table slot `slot'. */
+static void
+glyph_cache_remove(PyVGGlyphCache *self, Py_ssize_t slot)
+{
+    Py_ssize_t idx = self->table[slot];
+    struct glyph_entry *entry = &self->entries[idx];
+    PyVGPath *path = entry->path;
+
+    glyph_cache_unlink(self, idx);
+    self->table[slot] = SLOT_DELETED;
+    self->size -= entry->bytes;
+    self->count--;
+
+    entry->path = NULL;
+    entry->next = self->free_entry;
+    self->free_entry = idx;
+
+    Py_DECREF(path);
+}
+
+/* Evict least recently used entries, always keeping the newest. */
+static void
+glyph_cache_evict(PyVGGlyphCache *self)
+{
+    while (self->size > self->budget && self->tail >= 0 && self->tail != self->head) {
+        struct glyph_entry *entry = &self->entries[self->tail];
+
+        glyph_cache_remove(self, glyph_cache_find(self, entry->font, entry->glyph));
+    }
+}
+
+static void
+glyph_cache_clear(PyVGGlyphCache *self)
+{
+    while (self->tail >= 0) {
+        struct glyph_entry *entry = &self->entries[self->tail];
+
+        glyph_cache_remove(self, glyph_cache_find(self, entry->font, entry->glyph));
+    }
+}
+
+static int
+glyph_cache_check_idle(PyVGGlyphCache *self)
+{
+    if (self->executing) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "VGGlyphCache: cannot change the cache while drawing from it");
+        return -1;
+    }
+    return 0;
+}
+
+/* Bytes of path data `path' stores. */
+static Py_ssize_t
+glyph_path_bytes(PyVGPath *path)
+{
+    VGint datatype, segments, coords;
+
+    backend_wait();
+    datatype = vgGetParameteri(path->obj, VG_PATH_DATATYPE);
+    segments = vgGetParameteri(path->obj, VG_PATH_NUM_SEGMENTS);
+    coords = vgGetParameteri(path->obj, VG_PATH_NUM_COORDS);
+
+    if (check_error())
+        return -1;
+
+    return segments + (Py_ssize_t)coords * (datatype == VG_PATH_DATATYPE_S_8 ? 1 :
+                                            datatype == VG_PATH_DATATYPE_S_16 ? 2 : 4);
+}
+
+static int
+glyph_key(PyObject *key, VGint *font, VGint *glyph)
+{
+    if (!PyTuple_Check(key) || PyTuple_GET_SIZE(key) != 2) {
+        PyErr_SetString(PyExc_TypeError, "VGGlyphCache keys are (font, glyph) tuples");
+        return -1;
+    }
+    return PyArg_ParseTuple(key, (char *) "ii", font, glyph) ? 0 : -1;
+}
+
+
+PyDoc_STRVAR(PyVGGlyphCache_budget__doc__,
+".. attribute:: budget\n"
+"\n"
+"   Bytes of path data the cache may hold.  Lowering it evicts at once.\n"
+"\n"
+"   :type int: Byte budget.\n"
+);
+
+static PyObject*
+PyVGGlyphCache__get_budget(PyVGGlyphCache *self, void * UNUSED(closure))
+{
+    return PyLong_FromSsize_t(self->budget);
+}
+static int
+PyVGGlyphCache__set_budget(PyVGGlyphCache *self, PyObject *value, void * UNUSED(closure))
+{
+    Py_ssize_t budget;
+
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError, "cannot delete budget");
+        return -1;
+    }
+    if ((budget = PyNumber_AsSsize_t(value, PyExc_OverflowError)) == -1 && PyErr_Occurred())
+        return -1;
+    if (budget < 0) {
+        PyErr_SetString(PyExc_ValueError, "budget must be >= 0");
+        return -1;
+    }
+    if (glyph_cache_check_idle(self) < 0)
+        return -1;
+
+    self->budget = budget;
+    glyph_cache_evict(self);
+    return 0;
+}
+
+
+PyDoc_STRVAR(PyVGGlyphCache_size__doc__,
+".. attribute:: size\n"
+"\n"
+"   :type int: Bytes of path data held by the cache.\n"
+);
+
+static PyObject*
+PyVGGlyphCache__get_size(PyVGGlyphCache *self, void * UNUSED(closure))
+{
+    return PyLong_FromSsize_t(self->size);
+}
+
+static PyGetSetDef PyVGGlyphCache__getsets[] = {
+    {
+        (char*) "budget", /* attribute name */
+        (getter) PyVGGlyphCache__get_budget, /* C function to get the attribute */
+        (setter) PyVGGlyphCache__set_budget, /* C function to set the attribute */
+        PyVGGlyphCache_budget__doc__, /* optional doc string */
+        NULL /* optional additional data for getter and setter */
+    },
+    {
+        (char*) "size", /* attribute name */
+        (getter) PyVGGlyphCache__get_size, /* C function to get the attribute */
+        (setter) NULL, /* C function to set the attribute */
+        PyVGGlyphCache_size__doc__, /* optional doc string */
+        NULL /* optional additional data for getter and setter */
+    },
+    { NULL, NULL, NULL, NULL, NULL }
+};
+
+
+PyDoc_STRVAR(PyVGGlyphCache_clear__doc__,
+".. function:: clear()\n"
+"\n"
+"   Drop every entry.\n"
+);
+
+static PyObject *
+PyVGGlyphCache_clear(PyVGGlyphCache *self)
+{
+    if (glyph_cache_check_idle(self) < 0)
+        return NULL;
+
+    glyph_cache_clear(self);
+
+    Py_RETURN_NONE;
+}
+
+
+PyDoc_STRVAR(PyVGGlyphCache_draw_glyph_run__doc__,
+".. function:: draw_glyph_run(font, glyphs, positions[, paintModes])\n"
+"\n"
+"   Draw the cached path of every glyph in `glyphs', translated to its\n"
+"   position, on top of the current path-user-to-surface matrix.  The\n"
+"   matrix and matrix mode are restored afterwards.  Nothing is drawn\n"
+"   when a glyph is missing from the cache.\n"
+"\n"
+"   :arg font: The font id the glyphs were cached under.\n"
+"   :type font: int\n"
+"   :arg glyphs: The glyph ids.\n"
+"   :type glyphs: sequence of int\n"
+"   :arg positions: x, y per glyph.\n"
+"   :type positions: float32 buffer (array('f'), memoryview, ...)\n"
+"   :arg paintModes: Bitwise OR of VGPaintMode, VG_FILL_PATH by default.\n"
+"   :type paintModes: int\n"
+"\n"
+"   :error: KeyError (font, glyph) of the first missing glyph.\n"
+"   :error: VG_BAD_HANDLE_ERROR.\n"
+"   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
+);
+
+STATS_ENTRY(stats_draw_glyph_run, "VGGlyphCache.draw_glyph_run");
+
+static PyObject *
+PyVGGlyphCache_draw_glyph_run(PyVGGlyphCache *self, PyObject *args, PyObject *kwargs)
+{
+    VGint font;
+    PyObject *py_glyphs, *py_positions, *glyphs = NULL;
+    Py_buffer view;
+    const char *format;
+    VGbitfield paintModes = VG_FILL_PATH;
+    VGPath *handles = NULL;
+    const VGfloat *positions;
+    Py_ssize_t idx, count;
+
+    const char *keywords[] = {"font", "glyphs", "positions", "paintModes", NULL};
+
+    stats_scope stats(&stats_draw_glyph_run);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iOO|I", (char **) keywords, &font, &py_glyphs, &py_positions, &paintModes)) {
+        return NULL;
+    }
+
+    if (PyObject_GetBuffer(py_positions, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+        return NULL;
+
+    if ((glyphs = PySequence_Fast(py_glyphs, "glyphs must be a sequence")) == NULL)
+        goto fail;
+    count = PySequence_Fast_GET_SIZE(glyphs);
+
+    format = view.format ? view.format : "B";
+    if (*format == '@' || *format == '=')
+        format++;
+    if (strcmp(format, "f") != 0) {
+        PyErr_SetString(PyExc_TypeError,
+                        "VGGlyphCache.draw_glyph_run(): positions must be a float32 buffer");
+        goto fail;
+    }
+    if (view.len != count * 2 * (Py_ssize_t)sizeof(VGfloat)) {
+        PyErr_Format(PyExc_ValueError,
+                     "VGGlyphCache.draw_glyph_run(): positions holds %zd floats, %zd needed",
+                     view.len / (Py_ssize_t)sizeof(VGfloat), count * 2);
+        goto fail;
+    }
+    positions = (const VGfloat *)view.buf;
+
+    handles = PyMem_New(VGPath, count);
+    if (count && handles == NULL) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    for (idx = 0; idx < count; idx++) {
+        long glyph = PyLong_AsLong(PySequence_Fast_GET_ITEM(glyphs, idx));
+        Py_ssize_t slot;
+
+        if (glyph == -1 && PyErr_Occurred())
+            goto fail;
+
+        slot = glyph_cache_find(self, font, (VGint)glyph);
+        if (slot < 0) {
+            PyObject *key = Py_BuildValue((char *) "(il)", font, glyph);
+
+            if (key != NULL) {
+                PyErr_SetObject(PyExc_KeyError, key);
+                Py_DECREF(key);
+            }
+            goto fail;
+        }
+
+        glyph_cache_touch(self, self->table[slot]);
+        handles[idx] = self->entries[self->table[slot]].path->obj;
+    }
+
+    /* keeps the paths from being evicted without the GIL */
+    self->executing++;
+    VG_BEGIN_ALLOW_THREADS
+    {
+        VGfloat base[MATRIX_SIZE], matrix[MATRIX_SIZE];
+        VGint mode = vgGeti(VG_MATRIX_MODE);
+
+        vgSeti(VG_MATRIX_MODE, VG_MATRIX_PATH_USER_TO_SURFACE);
+        vgGetMatrix(base);
+        memcpy(matrix, base, sizeof(matrix));
+
+        for (idx = 0; idx < count; idx++) {
+            VGfloat x = positions[idx * 2], y = positions[idx * 2 + 1];
+
+            /* base * translate(x, y) */
+            matrix[6] = base[0] * x + base[3] * y + base[6];
+            matrix[7] = base[1] * x + base[4] * y + base[7];
+            matrix[8] = base[2] * x + base[5] * y + base[8];
+            vgLoadMatrix(matrix);
+            vgDrawPath(handles[idx], paintModes);
+        }
+
+        vgLoadMatrix(base);
+        vgSeti(VG_MATRIX_MODE, mode);
+    }
+    VG_END_ALLOW_THREADS
+    self->executing--;
+
+    PyMem_Free(handles);
+    PyBuffer_Release(&view);
+    Py_DECREF(glyphs);
+
+    if (check_error())
+        return NULL;
+
+    Py_RETURN_NONE;
+
+fail:
+    PyMem_Free(handles);
+    PyBuffer_Release(&view);
+    Py_XDECREF(glyphs);
+    return NULL;
+}
+
+static PyMethodDef PyVGGlyphCache_methods[] = {
+    {(char *) "clear",
+     (PyCFunction) PyVGGlyphCache_clear,
+     METH_NOARGS,
+     PyVGGlyphCache_clear__doc__
+    },
+    {(char *) "draw_glyph_run",
+     (PyCFunction) PyVGGlyphCache_draw_glyph_run,
+     METH_KEYWORDS|METH_VARARGS,
+     PyVGGlyphCache_draw_glyph_run__doc__
+    },
+    {NULL, NULL, 0, NULL}
+};
+
+static Py_ssize_t
+PyVGGlyphCache__mp_length(PyVGGlyphCache *self)
+{
+    return self->count;
+}
+
+static PyObject *
+PyVGGlyphCache__mp_subscript(PyVGGlyphCache *self, PyObject *key)
+{
+    VGint font, glyph;
+    Py_ssize_t slot;
+    PyVGPath *path;
+
+    if (glyph_key(key, &font, &glyph) < 0)
+        return NULL;
+
+    if ((slot = glyph_cache_find(self, font, glyph)) < 0) {
+        PyErr_SetObject(PyExc_KeyError, key);
+        return NULL;
+    }
+
+    glyph_cache_touch(self, self->table[slot]);
+    path = self->entries[self->table[slot]].path;
+
+    Py_INCREF(path);
+    return (PyObject *)path;
+}
+
+static int
+PyVGGlyphCache__mp_ass_subscript(PyVGGlyphCache *self, PyObject *key, PyObject *value)
+{
+    VGint font, glyph;
+    Py_ssize_t slot, idx, bytes;
+    struct glyph_entry *entry;
+
+    if (glyph_key(key, &font, &glyph) < 0 || glyph_cache_check_idle(self) < 0)
+        return -1;
+
+    slot = glyph_cache_find(self, font, glyph);
+
+    if (value == NULL) {
+        if (slot < 0) {
+            PyErr_SetObject(PyExc_KeyError, key);
+            return -1;
+        }
+        glyph_cache_remove(self, slot);
+        return 0;
+    }
+
+    if (!PyObject_TypeCheck(value, &PyVGPath_Type)) {
+        PyErr_SetString(PyExc_TypeError, "VGGlyphCache values must be VGPaths");
+        return -1;
+    }
+
+    if ((bytes = glyph_path_bytes((PyVGPath *)value)) < 0)
+        return -1;
+
+    if (slot >= 0)
+        glyph_cache_remove(self, slot);
+
+    if ((self->table_used + 1) * 4 > self->table_size * 3 &&
+        glyph_cache_rehash(self, self->count + 1) < 0) {
+        return -1;
+    }
+
+    if (self->free_entry >= 0) {
+        idx = self->free_entry;
+        self->free_entry = self->entries[idx].next;
+    }
+    else {
+        if (self->num_entries == self->max_entries) {
+            Py_ssize_t size = self->max_entries ? self->max_entries * 2 : 64;
+            struct glyph_entry *entries = self->entries;
+
+            if (PyMem_Resize(entries, struct glyph_entry, size) == NULL) {
+                PyErr_NoMemory();
+                return -1;
+            }
+            self->entries = entries;
+            self->max_entries = size;
+        }
+        idx = self->num_entries++;
+    }
+
+    entry = &self->entries[idx];
+    entry->font = font;
+    entry->glyph = glyph;
+    Py_INCREF(value);
+    entry->path = (PyVGPath *)value;
+    entry->bytes = bytes;
+
+    for (slot = glyph_hash(font, glyph) & (self->table_size - 1);
+         self->table[slot] >= 0; slot = (slot + 1) & (self->table_size - 1))
+        ;
+    if (self->table[slot] == SLOT_EMPTY)
+        self->table_used++;
+    self->table[slot] = idx;
+
+    glyph_cache_push_front(self, idx);
+    self->size += bytes;
+    self->count++;
+
+    glyph_cache_evict(self);
+    return 0;
+}
+
+static PyMappingMethods PyVGGlyphCache__tp_as_mapping = {
+	(lenfunc) PyVGGlyphCache__mp_length,	                /* mp_length */
+	(binaryfunc) PyVGGlyphCache__mp_subscript,	        /* mp_subscript */
+	(objobjargproc) PyVGGlyphCache__mp_ass_subscript,   /* mp_ass_subscript */
+};
+
+static int
+PyVGGlyphCache__sq_contains(PyVGGlyphCache *self, PyObject *key)
+{
+    VGint font, glyph;
+
+    if (glyph_key(key, &font, &glyph) < 0)
+        return -1;
+
+    return glyph_cache_find(self, font, glyph) >= 0;
+}
+
+static PySequenceMethods PyVGGlyphCache__tp_as_sequence = {
+    (lenfunc) NULL,                                     /* sq_length */
+    (binaryfunc) NULL,                                  /* sq_concat */
+    (ssizeargfunc) NULL,                                /* sq_repeat */
+    (ssizeargfunc) NULL,                                /* sq_item */
+    NULL,                                               /* sq_slice */
+    (ssizeobjargproc) NULL,                             /* sq_ass_item */
+    NULL,                                               /* sq_ass_slice */
+    (objobjproc) PyVGGlyphCache__sq_contains,           /* sq_contains */
+};
+
+static int
+PyVGGlyphCache__tp_init(PyVGGlyphCache *self, PyObject *args, PyObject *kwargs)
+{
+    Py_ssize_t budget;
+
+    const char *keywords[] = {"budget", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "n", (char **) keywords, &budget)) {
+        return -1;
+    }
+
+    if (budget < 0) {
+        PyErr_SetString(PyExc_ValueError, "budget must be >= 0");
+        return -1;
+    }
+
+    if (glyph_cache_check_idle(self) < 0)
+        return -1;
+
+    glyph_cache_clear(self);
+    self->budget = budget;
+    return 0;
+}
+
+static PyObject *
+PyVGGlyphCache__tp_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyVGGlyphCache *self = (PyVGGlyphCache *)type->tp_alloc(type, 0);
+
+    if (self != NULL) {
+        self->free_entry = self->head = self->tail = -1;
+    }
+    return (PyObject *)self;
+}
+
+static void
+PyVGGlyphCache__tp_dealloc(PyVGGlyphCache *self)
+{
+    glyph_cache_clear(self);
+    PyMem_Free(self->entries);
+    PyMem_Free(self->table);
+
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+PyTypeObject PyVGGlyphCache_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    (char *) "VG.VGGlyphCache",                /* tp_name */
+    sizeof(PyVGGlyphCache),                        /* tp_basicsize */
+    0,                                             /* tp_itemsize */
+    /* methods */
+    (destructor)PyVGGlyphCache__tp_dealloc,        /* tp_dealloc */
+    (printfunc)0,                                  /* tp_print */
+    (getattrfunc)NULL,                             /* tp_getattr */
+    (setattrfunc)NULL,                             /* tp_setattr */
+    (cmpfunc)NULL,                                 /* tp_compare */
+    (reprfunc)NULL,                                /* tp_repr */
+    (PyNumberMethods*)NULL,                        /* tp_as_number */
+    (PySequenceMethods*)&PyVGGlyphCache__tp_as_sequence, /* tp_as_sequence */
+    (PyMappingMethods*)&PyVGGlyphCache__tp_as_mapping, /* tp_as_mapping */
+    (hashfunc)NULL,                                /* tp_hash */
+    (ternaryfunc)NULL,                             /* tp_call */
+    (reprfunc)NULL,                                /* tp_str */
+    (getattrofunc)NULL,                            /* tp_getattro */
+    (setattrofunc)NULL,                            /* tp_setattro */
+    (PyBufferProcs*)NULL,                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                            /* tp_flags */
+    NULL,                                          /* Documentation string */
+    (traverseproc)NULL,                            /* tp_traverse */
+    (inquiry)NULL,                                 /* tp_clear */
+    (richcmpfunc)NULL,                             /* tp_richcompare */
+    0,                                             /* tp_weaklistoffset */
+    (getiterfunc)NULL,                             /* tp_iter */
+    (iternextfunc)NULL,                            /* tp_iternext */
+    (struct PyMethodDef*)PyVGGlyphCache_methods,   /* tp_methods */
+    (struct PyMemberDef*)0,                        /* tp_members */
+    PyVGGlyphCache__getsets,                       /* tp_getset */
+    NULL,                                          /* tp_base */
+    NULL,                                          /* tp_dict */
+    (descrgetfunc)NULL,                            /* tp_descr_get */
+    (descrsetfunc)NULL,                            /* tp_descr_set */
+    0,                                             /* tp_dictoffset */
+    (initproc)PyVGGlyphCache__tp_init,             /* tp_init */
+    (allocfunc)PyType_GenericAlloc,                /* tp_alloc */
+    (newfunc)PyVGGlyphCache__tp_new,               /* tp_new */
+    (freefunc)0,                                   /* tp_free */
+    (inquiry)NULL,                                 /* tp_is_gc */
+    NULL,                                          /* tp_bases */
+    NULL,                                          /* tp_mro */
+    NULL,                                          /* tp_cache */
+    NULL,                                          /* tp_subclasses */
+    NULL,                                          /* tp_weaklist */
+    (destructor) NULL                              /* tp_del */
+};
@@ -34,7 +34,9 @@ PyVGImage__tp_init(PyVGImage *self, PyObject *args, PyObject *kwargs)
         return -1;
     }
 
+    VG_BEGIN_ALLOW_THREADS
     self->obj = vgCreateImage(format, width, height, allowedQuality);
+    VG_END_ALLOW_THREADS
 
     return check_error() ? -1 : 0;
 }
@@ -61,21 +63,29 @@ PyDoc_STRVAR(OpenVG_vgChildImage__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+static const char *const OpenVG_vgChildImage_keywords[] = {"x", "y", "width", "height", NULL};
+static const struct fast_parser OpenVG_vgChildImage_parser = {"child", OpenVG_vgChildImage_keywords, 4, 4};
+
 static PyObject *
-OpenVG_vgChildImage(PyVGImage *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgChildImage(PyVGImage *self, FAST_ARGS)
 {
+    PyObject *argv[4];
     PyObject *py_retval;
     VGint x;
     VGint y;
     VGint width;
     VGint height;
-    const char *keywords[] = {"x", "y", "width", "height", NULL};
     PyVGImage *py_VGImage;
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiii", (char **) keywords, &x, &y, &width, &height)) {
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgChildImage_parser, argv) ||
+        !fast_int(argv[0], &x) ||
+        !fast_int(argv[1], &y) ||
+        !fast_int(argv[2], &width) ||
+        !fast_int(argv[3], &height)) {
         return NULL;
     }
 
+    backend_wait();
     VGImage retval = vgChildImage(self->obj, x, y, width, height);
 
     if (check_error()) {
@@ -85,7 +95,7 @@ OpenVG_vgChildImage(PyVGImage *self, PyObject *args, PyObject *kwargs)
     py_VGImage = PyObject_New(PyVGImage, &PyVGImage_Type);
     py_VGImage->obj = retval;
 
-    py_retval = Py_BuildValue((char *) "N", py_VGImage);
+    py_retval = (PyObject *) py_VGImage;
     return py_retval;
 }
 
@@ -108,20 +118,41 @@ PyDoc_STRVAR(OpenVG_vgClearImage__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgClearImage, "VGImage.clear");
+
+static const char *const OpenVG_vgClearImage_keywords[] = {"x", "y", "width", "height", NULL};
+static const struct fast_parser OpenVG_vgClearImage_parser = {"clear", OpenVG_vgClearImage_keywords, 4, 4};
+
 static PyObject *
-OpenVG_vgClearImage(PyVGImage *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgClearImage(PyVGImage *self, FAST_ARGS)
 {
+    PyObject *argv[4];
     VGint x;
     VGint y;
     VGint width;
     VGint height;
-    const char *keywords[] = {"x", "y", "width", "height", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiii", (char **) keywords, &x, &y, &width, &height)) {
+
+    stats_scope stats(&stats_vgClearImage);
+    stats.handle = self->obj;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgClearImage_parser, argv) ||
+        !fast_int(argv[0], &x) ||
+        !fast_int(argv[1], &y) ||
+        !fast_int(argv[2], &width) ||
+        !fast_int(argv[3], &height)) {
         return NULL;
     }
 
-    vgClearImage(self->obj, x, y, width, height);
+    /* a few pixels don't pay for releasing the GIL */
+    if ((double)width * height < BACKEND_RELEASE_PIXELS) {
+        backend_wait();
+        vgClearImage(self->obj, x, y, width, height);
+    }
+    else {
+        VG_BEGIN_ALLOW_THREADS
+        vgClearImage(self->obj, x, y, width, height);
+        VG_END_ALLOW_THREADS
+    }
 
     if (check_error()) {
         return NULL;
@@ -132,49 +163,59 @@ OpenVG_vgClearImage(PyVGImage *self, PyObject *args, PyObject *kwargs)
 
 
 PyDoc_STRVAR(OpenVG_vgColorMatrix__doc__,
-".. function:: color_matrix(x, y, width, height)\n"
+".. function:: color_matrix(src, matrix)\n"
 "\n"
 "   Computes a linear combination of color and alpha values from the normalized source image src at each pixel.\n"
 "\n"
+"   The matrix is 4x5 in column-major order: the weights of the source\n"
+"   R, G, B and A in each output channel, then the offset of each.\n"
+"\n"
 "   :arg src: Source image.\n"
 "   :type src: VGImage\n"
 "   :arg matrix: Color Matrix.\n"
-"   :type matrix: float[16]\n"
+"   :type matrix: float[20]\n"
 "\n"
 "   :error: VG_BAD_HANDLE_ERROR.\n"
 "   :error: VG_IMAGE_IN_USE_ERROR.\n"
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgColorMatrix, "VGImage.color_matrix");
+
 static PyObject *
 OpenVG_vgColorMatrix(PyVGImage *self, PyObject *args, PyObject *kwargs)
 {
     PyVGImage *src;
-    VGfloat matrix[MATRIX_SIZE];
+    VGfloat matrix[20];
     PyObject *py_list;
     int idx;
     PyObject *element;
     const char *keywords[] = {"src", "matrix", NULL};
+
+    stats_scope stats(&stats_vgColorMatrix);
+    stats.handle = self->obj;
     
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!O!", (char **) keywords, &PyVGImage_Type, &src, &PyList_Type, &py_list)) {
         return NULL;
     }
 
-    if (PyList_Size(py_list) != 16) {
-        PyErr_SetString(PyExc_TypeError, "Parameter `matrix' must be a list of 16 floats");
+    if (PyList_Size(py_list) != 20) {
+        PyErr_SetString(PyExc_TypeError, "Parameter `matrix' must be a list of 20 floats");
         return NULL;
     }
 
-    for (idx = 0; idx < 16; idx++) {
+    for (idx = 0; idx < 20; idx++) {
         element = PyList_GET_ITEM(py_list, idx);
         if (!PyFloat_Check(element)) {
-            PyErr_SetString(PyExc_TypeError, "Parameter `matrix' must be a list of 16 floats");
+            PyErr_SetString(PyExc_TypeError, "Parameter `matrix' must be a list of 20 floats");
             return NULL;
         }
         matrix[idx] = (float) PyFloat_AsDouble(element);
     }
 
+    VG_BEGIN_ALLOW_THREADS
     vgColorMatrix(self->obj, src->obj, matrix);
+    VG_END_ALLOW_THREADS
 
     if (check_error()) {
         return NULL;
@@ -215,6 +256,8 @@ PyDoc_STRVAR(OpenVG_vgConvolve__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgConvolve, "VGImage.convolve");
+
 static PyObject *
 OpenVG_vgConvolve(PyVGImage *self, PyObject *args, PyObject *kwargs)
 {
@@ -228,8 +271,11 @@ OpenVG_vgConvolve(PyVGImage *self, PyObject *args, PyObject *kwargs)
     int count, idx;
 
     const char *keywords[] = {"src", "kernelWidth", "kernelHeight", "shiftX", "shiftY", "kernel", "scale", "bias", "tilingMode", NULL};
+
+    stats_scope stats(&stats_vgConvolve);
+    stats.handle = self->obj;
     
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!iiii0!ffi", (char **) keywords, &PyVGImage_Type, &src, &kernelWidth, &kernelHeight, &shiftX, &shiftY, &PyList_Type, &py_list, &scale, &bias, &tilingMode)) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!iiiiO!ffi", (char **) keywords, &PyVGImage_Type, &src, &kernelWidth, &kernelHeight, &shiftX, &shiftY, &PyList_Type, &py_list, &scale, &bias, &tilingMode)) {
         return NULL;
     }
 
@@ -242,13 +288,23 @@ OpenVG_vgConvolve(PyVGImage *self, PyObject *args, PyObject *kwargs)
     }
 
     kernel = (VGshort *)malloc(sizeof(VGshort) * count);
+    if (kernel == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
     for (idx = 0; idx < count; idx++) {
         PyObject *element = PyList_GET_ITEM(py_list, idx);
         kernel[idx] = (VGshort) PyLong_AsLong(element);
     }
+    if (PyErr_Occurred()) {
+        free(kernel);
+        return NULL;
+    }
 
+    VG_BEGIN_ALLOW_THREADS
     vgConvolve(self->obj, src->obj, kernelWidth, kernelHeight,
                shiftX, shiftY, kernel, scale, bias, (VGTilingMode)tilingMode);
+    VG_END_ALLOW_THREADS
 
     free(kernel);
 
@@ -287,9 +343,15 @@ PyDoc_STRVAR(OpenVG_vgCopyImage__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgCopyImage, "VGImage.copy");
+
+static const char *const OpenVG_vgCopyImage_keywords[] = {"dx", "dy", "src", "sx", "sy", "width", "height", "dither", NULL};
+static const struct fast_parser OpenVG_vgCopyImage_parser = {"copy", OpenVG_vgCopyImage_keywords, 8, 8};
+
 static PyObject *
-OpenVG_vgCopyImage(PyVGImage *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgCopyImage(PyVGImage *self, FAST_ARGS)
 {
+    PyObject *argv[8];
     VGint dx;
     VGint dy;
     PyVGImage *src;
@@ -298,14 +360,28 @@ OpenVG_vgCopyImage(PyVGImage *self, PyObject *args, PyObject *kwargs)
     VGint width;
     VGint height;
     PyObject *dither;
-    const char *keywords[] = {"dx", "dy", "src", "sx", "sy", "width", "height", "dither", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiO!iiiiO!", (char **) keywords, &dx, &dy, &PyVGImage_Type, &src, &sx, &sy, &width, &height, &PyBool_Type, &dither)) {
+    VGboolean c_dither;
+
+    stats_scope stats(&stats_vgCopyImage);
+    stats.handle = self->obj;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgCopyImage_parser, argv) ||
+        !fast_int(argv[0], &dx) ||
+        !fast_int(argv[1], &dy) ||
+        !fast_object(argv[2], &PyVGImage_Type, &src) ||
+        !fast_int(argv[3], &sx) ||
+        !fast_int(argv[4], &sy) ||
+        !fast_int(argv[5], &width) ||
+        !fast_int(argv[6], &height) ||
+        !fast_object(argv[7], &PyBool_Type, &dither)) {
         return NULL;
     }
 
-    vgCopyImage(self->obj, dx, dy, src->obj, sx, sy, width, height,
-                (VGboolean)PyObject_IsTrue(dither));
+    c_dither = (VGboolean)PyObject_IsTrue(dither);
+
+    VG_BEGIN_ALLOW_THREADS
+    vgCopyImage(self->obj, dx, dy, src->obj, sx, sy, width, height, c_dither);
+    VG_END_ALLOW_THREADS
 
     Py_RETURN_NONE;
 }
@@ -320,10 +396,17 @@ PyDoc_STRVAR(OpenVG_vgDrawImage__doc__,
 "   :error: VG_IMAGE_IN_USE_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgDrawImage, "VGImage.draw");
+
 static PyObject *
 OpenVG_vgDrawImage(PyVGImage *self, PyObject *args, PyObject *kwargs)
 {
+    stats_scope stats(&stats_vgDrawImage);
+    stats.handle = self->obj;
+
+    VG_BEGIN_ALLOW_THREADS
     vgDrawImage(self->obj);
+    VG_END_ALLOW_THREADS
 
     if (check_error())
         return NULL;
@@ -352,20 +435,34 @@ PyDoc_STRVAR(OpenVG_vgGaussianBlur__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgGaussianBlur, "VGImage.gaussian_blur");
+
+static const char *const OpenVG_vgGaussianBlur_keywords[] = {"src", "stdDeviationX", "stdDeviationY", "tilingMode", NULL};
+static const struct fast_parser OpenVG_vgGaussianBlur_parser = {"gaussian_blur", OpenVG_vgGaussianBlur_keywords, 4, 4};
+
 static PyObject *
-OpenVG_vgGaussianBlur(PyVGImage *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgGaussianBlur(PyVGImage *self, FAST_ARGS)
 {
+    PyObject *argv[4];
     PyVGImage *src;
     VGfloat stdDeviationX;
     VGfloat stdDeviationY;
-    VGTilingMode tilingMode;
-    const char *keywords[] = {"src", "stdDeviationX", "stdDeviationY", "tilingMode", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!ffi", (char **) keywords, &PyVGImage_Type, &src, &stdDeviationX, &stdDeviationY, &tilingMode)) {
+    VGint tilingMode;
+
+    stats_scope stats(&stats_vgGaussianBlur);
+    stats.handle = self->obj;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgGaussianBlur_parser, argv) ||
+        !fast_object(argv[0], &PyVGImage_Type, &src) ||
+        !fast_float(argv[1], &stdDeviationX) ||
+        !fast_float(argv[2], &stdDeviationY) ||
+        !fast_int(argv[3], &tilingMode)) {
         return NULL;
     }
 
-    vgGaussianBlur(self->obj, src->obj, stdDeviationX, stdDeviationY, tilingMode);
+    VG_BEGIN_ALLOW_THREADS
+    vgGaussianBlur(self->obj, src->obj, stdDeviationX, stdDeviationY, (VGTilingMode)tilingMode);
+    VG_END_ALLOW_THREADS
 
     if (check_error()) {
         return NULL;
@@ -393,6 +490,7 @@ OpenVG_vgGetParent(PyVGImage *self, PyObject *args, PyObject *kwargs)
     PyObject *py_retval;
     PyVGImage *py_VGImage;
     
+    backend_wait();
     VGImage retval = vgGetParent(self->obj);
 
     if (check_error()) {
@@ -402,7 +500,7 @@ OpenVG_vgGetParent(PyVGImage *self, PyObject *args, PyObject *kwargs)
     py_VGImage = PyObject_New(PyVGImage, &PyVGImage_Type);
     py_VGImage->obj = retval;
 
-    py_retval = Py_BuildValue((char *) "N", py_VGImage);
+    py_retval = (PyObject *) py_VGImage;
 
     return py_retval;
 }
@@ -441,6 +539,8 @@ PyDoc_STRVAR(OpenVG_vgSeparableConvolve__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgSeparableConvolve, "VGImage.separable_convolve");
+
 static PyObject *
 OpenVG_vgSeparableConvolve(PyVGImage *self, PyObject *args, PyObject *kwargs)
 {
@@ -459,6 +559,9 @@ OpenVG_vgSeparableConvolve(PyVGImage *self, PyObject *args, PyObject *kwargs)
     int idx;
 
     const char *keywords[] = {"src", "kernelWidth", "kernelHeight", "shiftX", "shiftY", "kernelX", "kernelY", "scale", "bias", "tilingMode", NULL};
+
+    stats_scope stats(&stats_vgSeparableConvolve);
+    stats.handle = self->obj;
     
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!iiiiO!O!ffi", (char **) keywords, &PyVGImage_Type, &src, &kernelWidth, &kernelHeight, &shiftX, &shiftY, &PyList_Type, &py_listX, &PyList_Type, &py_listY, &scale, &bias, &tilingMode)) {
         return NULL;
@@ -471,18 +574,33 @@ OpenVG_vgSeparableConvolve(PyVGImage *self, PyObject *args, PyObject *kwargs)
     }
 
     kernelX = (VGshort *)malloc(sizeof(VGshort) * kernelWidth);
+    kernelY = (VGshort *)malloc(sizeof(VGshort) * kernelHeight);
+    if (kernelX == NULL || kernelY == NULL) {
+        free(kernelX);
+        free(kernelY);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
     for (idx = 0; idx < kernelWidth; idx++) {
         PyObject *element = PyList_GET_ITEM(py_listX, idx);
         kernelX[idx] = (VGshort) PyLong_AsLong(element);
     }
 
-    kernelY = (VGshort *)malloc(sizeof(VGshort) * kernelHeight);
     for (idx = 0; idx < kernelHeight; idx++) {
         PyObject *element = PyList_GET_ITEM(py_listY, idx);
         kernelY[idx] = (VGshort) PyLong_AsLong(element);
     }
 
+    if (PyErr_Occurred()) {
+        free(kernelX);
+        free(kernelY);
+        return NULL;
+    }
+
+    VG_BEGIN_ALLOW_THREADS
     vgSeparableConvolve(self->obj,src->obj, kernelWidth, kernelHeight, shiftX, shiftY, kernelX, kernelY, scale, bias, (VGTilingMode)tilingMode);
+    VG_END_ALLOW_THREADS
 
     free(kernelX);
     free(kernelY);
@@ -496,12 +614,12 @@ OpenVG_vgSeparableConvolve(PyVGImage *self, PyObject *args, PyObject *kwargs)
 
 
 PyDoc_STRVAR(OpenVG_vgImageSubData__doc__,
-".. function:: set_sub_data(data, dataStride, dataFormat, x, y, width, height)\n"
+".. function:: set_sub_data(data, dataStride, dataFormat, x, y, width, height[, transferFormat])\n"
 "\n"
 "   Fill region with `data'.\n"
 "\n"
 "   :arg data: Raw pixel data.\n"
-"   :type data: bytes\n"
+"   :type data: bytes, bytearray, memoryview, mmap, ...\n"
 "   :arg dataStride: Stride between pixel rows.\n"
 "   :type dataStride: int\n"
 "   :arg dataFormat: Pixel data format.\n"
@@ -513,6 +631,9 @@ PyDoc_STRVAR(OpenVG_vgImageSubData__doc__,
 "   :arg width: Width of the sub-region.\n"
 "   :type width: int\n"
 "   :arg height: Height of the sub-region.\n"
+"   :arg transferFormat: Format exchanged with OpenVG, the bindings convert\n"
+"      between it and `dataFormat'.\n"
+"   :type transferFormat: VGImageFormat\n"
 "\n"
 "   :error: VG_BAD_HANDLE_ERROR.\n"
 "   :error: VG_IMAGE_IN_USE_ERROR.\n"
@@ -520,27 +641,72 @@ PyDoc_STRVAR(OpenVG_vgImageSubData__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgImageSubData, "VGImage.set_sub_data");
+
 static PyObject *
 OpenVG_vgImageSubData(PyVGImage *self, PyObject *args, PyObject *kwargs)
 {
     PyObject *data;
+    Py_buffer view;
+    Py_ssize_t bytes, offset;
     VGint dataStride;
     VGImageFormat dataFormat;
     VGint x, y, width, height;
+    VGint transferFormat = -1;
+    pixel_stage stage;
+
+    const char *keywords[] = {"data", "dataStride", "dataFormat", "x", "y", "width", "height", "transferFormat", NULL};
 
-    const char *keywords[] = {"data", "dataStride", "dataFormat", "x", "y", "width", "height", NULL};
+    stats_scope stats(&stats_vgImageSubData);
+    stats.handle = self->obj;
     
     if (!PyArg_ParseTupleAndKeywords(args, kwargs,
-                                     (char *) "O!iiiiii",
+                                     (char *) "Oiiiiii|i",
                                      (char **) keywords,
-                                     &PyByteArray_Type, &data,
+                                     &data,
                                      &dataStride, &dataFormat,
-                                     &x, &y, &width, &height)) {
+                                     &x, &y, &width, &height,
+                                     &transferFormat)) {
         return NULL;
     }
 
-    vgImageSubData(self->obj, PyByteArray_AsString(data),
-                   dataStride, dataFormat, x, y, width, height);
+    if ((bytes = pixel_data_size(dataStride, dataFormat, width, height, &offset)) < 0)
+        return NULL;
+    stats.bytes = bytes;
+
+    /* the export also keeps `data' from being resized without the GIL */
+    if (PyObject_GetBuffer(data, &view, PyBUF_C_CONTIGUOUS) < 0)
+        return NULL;
+
+    if (view.len < bytes) {
+        PyBuffer_Release(&view);
+        PyErr_Format(PyExc_ValueError,
+                     "VGImage.set_sub_data(): data holds %zd bytes, %zd needed",
+                     view.len, bytes);
+        return NULL;
+    }
+
+    if (pixel_stage_init(&stage, dataFormat, transferFormat, width, height) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    if (stage.data) {
+        pixel_stage_pack(&stage, (char *)view.buf + offset, dataStride,
+                         dataFormat, width, height);
+    }
+
+    VG_BEGIN_ALLOW_THREADS
+    if (stage.data)
+        vgImageSubData(self->obj, stage.data, stage.stride, stage.format,
+                       x, y, width, height);
+    else
+        vgImageSubData(self->obj, (char *)view.buf + offset, dataStride, dataFormat,
+                       x, y, width, height);
+    VG_END_ALLOW_THREADS
+
+    pixel_stage_free(&stage);
+    PyBuffer_Release(&view);
 
     if (check_error()) {
         return NULL;
@@ -551,7 +717,7 @@ OpenVG_vgImageSubData(PyVGImage *self, PyObject *args, PyObject *kwargs)
 
 
 PyDoc_STRVAR(OpenVG_vgGetImageSubData__doc__,
-".. function:: get_sub_data(dataStride, dataFormat, x, y, width, height)\n"
+".. function:: get_sub_data(dataStride, dataFormat, x, y, width, height[, transferFormat])\n"
 "\n"
 "   Copy pixel values to `data'.\n"
 "\n"
@@ -566,6 +732,9 @@ PyDoc_STRVAR(OpenVG_vgGetImageSubData__doc__,
 "   :arg width: Width of the sub-region.\n"
 "   :type width: int\n"
 "   :arg height: Height of the sub-region.\n"
+"   :arg transferFormat: Format exchanged with OpenVG, the bindings convert\n"
+"      between it and `dataFormat'.\n"
+"   :type transferFormat: VGImageFormat\n"
 "   :return: Raw pixel data.\n"
 "   :rtype: bytearray\n"
 "\n"
@@ -575,6 +744,8 @@ PyDoc_STRVAR(OpenVG_vgGetImageSubData__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgGetImageSubData, "VGImage.get_sub_data");
+
 static PyObject *
 OpenVG_vgGetImageSubData(PyVGImage *self, PyObject *args, PyObject *kwargs)
 {
@@ -583,46 +754,156 @@ OpenVG_vgGetImageSubData(PyVGImage *self, PyObject *args, PyObject *kwargs)
     VGint dataStride;
     VGImageFormat dataFormat;
     VGint x, y, width, height;
-    int bytes;
+    VGint transferFormat = -1;
+    pixel_stage stage;
+    Py_ssize_t bytes, offset;
 
-    const char *keywords[] = {"dataStride", "dataFormat", "x", "y", "width", "height", NULL};
+    const char *keywords[] = {"dataStride", "dataFormat", "x", "y", "width", "height", "transferFormat", NULL};
+
+    stats_scope stats(&stats_vgGetImageSubData);
+    stats.handle = self->obj;
     
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiiiii", (char **) keywords, &dataStride, &dataFormat, &x, &y, &width, &height)) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiiiii|i", (char **) keywords, &dataStride, &dataFormat, &x, &y, &width, &height, &transferFormat)) {
         return NULL;
     }
 
-    bytes = width*height;
-    switch (dataFormat) {
-        case VG_sL_8:
-        case VG_lL_8:
-        case VG_A_8:  /* 1 byte/pixel */
-            break;
-        case VG_sRGB_565:
-        case VG_sRGBA_5551:
-        case VG_sRGBA_4444:  /* 2 bytes/pixel */
-            bytes *= 2;
-            break;
-        default:  /* 4 bytes/pixel */
-            bytes *= 4;
+    if ((bytes = pixel_data_size(dataStride, dataFormat, width, height, &offset)) < 0)
+        return NULL;
+    stats.bytes = bytes;
+
+    if (pixel_stage_init(&stage, dataFormat, transferFormat, width, height) < 0)
+        return NULL;
+
+    if ((py_retval = PyByteArray_FromStringAndSize(NULL, bytes)) == NULL) {
+        pixel_stage_free(&stage);
+        return NULL;
     }
 
-    data = (char *)malloc(sizeof(char) * bytes);
+    data = PyByteArray_AS_STRING(py_retval) + offset;
 
-    vgGetImageSubData(self->obj, data, dataStride, dataFormat, x, y, width, height);
+    VG_BEGIN_ALLOW_THREADS
+    if (stage.data)
+        vgGetImageSubData(self->obj, stage.data, stage.stride, stage.format,
+                          x, y, width, height);
+    else
+        vgGetImageSubData(self->obj, data, dataStride, dataFormat, x, y, width, height);
+    VG_END_ALLOW_THREADS
 
     if (check_error()) {
-        free(data);
+        pixel_stage_free(&stage);
+        Py_DECREF(py_retval);
         return NULL;
     }
 
-    py_retval = Py_BuildValue((char *) "N", PyByteArray_FromStringAndSize(data, bytes));
-
-    free(data);
+    if (stage.data) {
+        pixel_stage_unpack(&stage, data, dataStride, dataFormat, width, height);
+        pixel_stage_free(&stage);
+    }
 
     return py_retval;
 }
 
 
+PyDoc_STRVAR(OpenVG_vgGetImageSubDataInto__doc__,
+".. function:: get_sub_data_into(buffer, dataStride, dataFormat, x, y, width, height[, transferFormat])\n"
+"\n"
+"   Copy pixel values straight into `buffer'.\n"
+"\n"
+"   :arg buffer: Destination, any writable contiguous buffer.\n"
+"   :type buffer: bytearray, memoryview, mmap, ...\n"
+"   :arg dataStride: Stride between pixel rows.\n"
+"   :type dataStride: int\n"
+"   :arg dataFormat: Pixel data format.\n"
+"   :type dataFormat: VGImageFormat\n"
+"   :arg x: Start position x.\n"
+"   :type x: int\n"
+"   :arg y: Start position y.\n"
+"   :type y: int\n"
+"   :arg width: Width of the sub-region.\n"
+"   :type width: int\n"
+"   :arg height: Height of the sub-region.\n"
+"   :arg transferFormat: Format exchanged with OpenVG, the bindings convert\n"
+"      between it and `dataFormat'.\n"
+"   :type transferFormat: VGImageFormat\n"
+"   :return: Number of bytes spanned in `buffer'.\n"
+"   :rtype: int\n"
+"\n"
+"   :error: VG_BAD_HANDLE_ERROR.\n"
+"   :error: VG_IMAGE_IN_USE_ERROR.\n"
+"   :error: VG_UNSUPPORTED_IMAGE_FORMAT_ERROR.\n"
+"   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
+);
+
+STATS_ENTRY(stats_vgGetImageSubDataInto, "VGImage.get_sub_data_into");
+
+static PyObject *
+OpenVG_vgGetImageSubDataInto(PyVGImage *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *buffer;
+    Py_buffer view;
+    VGint dataStride;
+    VGImageFormat dataFormat;
+    VGint x, y, width, height;
+    VGint transferFormat = -1;
+    pixel_stage stage;
+    Py_ssize_t bytes, offset;
+
+    const char *keywords[] = {"buffer", "dataStride", "dataFormat", "x", "y", "width", "height", "transferFormat", NULL};
+
+    stats_scope stats(&stats_vgGetImageSubDataInto);
+    stats.handle = self->obj;
+    
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "Oiiiiii|i", (char **) keywords, &buffer, &dataStride, &dataFormat, &x, &y, &width, &height, &transferFormat)) {
+        return NULL;
+    }
+
+    if ((bytes = pixel_data_size(dataStride, dataFormat, width, height, &offset)) < 0)
+        return NULL;
+    stats.bytes = bytes;
+
+    if (PyObject_GetBuffer(buffer, &view, PyBUF_WRITABLE) < 0)
+        return NULL;
+
+    if (view.len < bytes) {
+        PyBuffer_Release(&view);
+        PyErr_Format(PyExc_ValueError,
+                     "VGImage.get_sub_data_into(): buffer holds %zd bytes, %zd needed",
+                     view.len, bytes);
+        return NULL;
+    }
+
+    if (pixel_stage_init(&stage, dataFormat, transferFormat, width, height) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    VG_BEGIN_ALLOW_THREADS
+    if (stage.data)
+        vgGetImageSubData(self->obj, stage.data, stage.stride, stage.format,
+                          x, y, width, height);
+    else
+        vgGetImageSubData(self->obj, (char *)view.buf + offset, dataStride, dataFormat,
+                          x, y, width, height);
+    VG_END_ALLOW_THREADS
+
+    if (check_error()) {
+        pixel_stage_free(&stage);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    if (stage.data) {
+        pixel_stage_unpack(&stage, (char *)view.buf + offset, dataStride,
+                           dataFormat, width, height);
+        pixel_stage_free(&stage);
+    }
+
+    PyBuffer_Release(&view);
+
+    return PyLong_FromSsize_t(bytes);
+}
+
+
 PyDoc_STRVAR(OpenVG_vgLookup__doc__,
 ".. function:: lookup(src, redLUT, greenLUT, blueLUT, alphaLUT,\n"
 "                     outputLinear, outputPremultiplied)\n"
@@ -651,16 +932,23 @@ PyDoc_STRVAR(OpenVG_vgLookup__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgLookup, "VGImage.lookup");
+
 static PyObject *
 OpenVG_vgLookup(PyVGImage *self, PyObject *args, PyObject *kwargs)
 {
     PyVGImage *src;
     PyObject *redLUT, *greenLUT, *blueLUT, *alphaLUT;
     PyObject *outputLinear, *outputPremultiplied;
+    VGubyte lut[4][256];
+    VGboolean linear, premultiplied;
 
     const char *keywords[] = {"src", "redLUT", "greenLUT", "blueLUT",
                               "alphaLUT", "outputLinear", "outputPremultiplied",
                               NULL};
+
+    stats_scope stats(&stats_vgLookup);
+    stats.handle = self->obj;
     
     if (!PyArg_ParseTupleAndKeywords(args, kwargs,(char *) "O!O!O!O!O!O!O!",
                                      
@@ -684,13 +972,18 @@ OpenVG_vgLookup(PyVGImage *self, PyObject *args, PyObject *kwargs)
         return NULL;
     }
 
-    vgLookup(self->obj, src->obj,
-             (const VGubyte*)PyByteArray_AsString(redLUT),
-             (const VGubyte*)PyByteArray_AsString(greenLUT),
-             (const VGubyte*)PyByteArray_AsString(blueLUT),
-             (const VGubyte*)PyByteArray_AsString(alphaLUT),
-             (VGboolean)PyObject_IsTrue(outputLinear),
-             (VGboolean)PyObject_IsTrue(outputPremultiplied));
+    /* the tables are copied so the GIL can be released */
+    memcpy(lut[0], PyByteArray_AsString(redLUT), 256);
+    memcpy(lut[1], PyByteArray_AsString(greenLUT), 256);
+    memcpy(lut[2], PyByteArray_AsString(blueLUT), 256);
+    memcpy(lut[3], PyByteArray_AsString(alphaLUT), 256);
+    linear = (VGboolean)PyObject_IsTrue(outputLinear);
+    premultiplied = (VGboolean)PyObject_IsTrue(outputPremultiplied);
+
+    VG_BEGIN_ALLOW_THREADS
+    vgLookup(self->obj, src->obj, lut[0], lut[1], lut[2], lut[3],
+             linear, premultiplied);
+    VG_END_ALLOW_THREADS
 
     if (check_error()) {
         return NULL;
@@ -722,6 +1015,8 @@ PyDoc_STRVAR(OpenVG_vgLookupSingle__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgLookupSingle, "VGImage.lookup_single");
+
 static PyObject *
 OpenVG_vgLookupSingle(PyVGImage *self, PyObject *args, PyObject *kwargs)
 {
@@ -730,10 +1025,14 @@ OpenVG_vgLookupSingle(PyVGImage *self, PyObject *args, PyObject *kwargs)
     PyObject *py_list;
     VGImageChannel sourceChannel;
     PyObject *outputLinear, *outputPremultiplied;
+    VGboolean linear, premultiplied;
     int idx;
 
     const char *keywords[] = {"src", "lookupTable", "sourceChannel",
                               "outputLinear", "outputPremultiplied", NULL};
+
+    stats_scope stats(&stats_vgLookupSingle);
+    stats.handle = self->obj;
     
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!O!iO!O!",
                                     (char **) keywords,
@@ -756,9 +1055,13 @@ OpenVG_vgLookupSingle(PyVGImage *self, PyObject *args, PyObject *kwargs)
         lookupTable[idx] = (VGubyte) PyLong_AsUnsignedLong(element);
     }
 
+    linear = (VGboolean)PyObject_IsTrue(outputLinear);
+    premultiplied = (VGboolean)PyObject_IsTrue(outputPremultiplied);
+
+    VG_BEGIN_ALLOW_THREADS
     vgLookupSingle(self->obj, src->obj, (const VGuint*)lookupTable, sourceChannel,
-                   (VGboolean)PyObject_IsTrue(outputLinear),
-                   (VGboolean)PyObject_IsTrue(outputPremultiplied));
+                   linear, premultiplied);
+    VG_END_ALLOW_THREADS
 
     if (check_error()) {
         return NULL;
@@ -770,12 +1073,12 @@ OpenVG_vgLookupSingle(PyVGImage *self, PyObject *args, PyObject *kwargs)
 static PyMethodDef PyVGImage_methods[] = {
     {(char *) "child",
      (PyCFunction) OpenVG_vgChildImage,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgChildImage__doc__
     },
     {(char *) "clear",
      (PyCFunction) OpenVG_vgClearImage,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgClearImage__doc__
     },
     {(char *) "color_matrix",
@@ -790,7 +1093,7 @@ static PyMethodDef PyVGImage_methods[] = {
     },
     {(char *) "copy",
      (PyCFunction) OpenVG_vgCopyImage,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgCopyImage__doc__
     },
     {(char *) "draw",
@@ -800,7 +1103,7 @@ static PyMethodDef PyVGImage_methods[] = {
     },
     {(char *) "gaussian_blur",
      (PyCFunction) OpenVG_vgGaussianBlur,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgGaussianBlur__doc__
     },
     {(char *) "lookup",
@@ -828,6 +1131,11 @@ static PyMethodDef PyVGImage_methods[] = {
      METH_KEYWORDS|METH_VARARGS,
      OpenVG_vgGetImageSubData__doc__
     },
+    {(char *) "get_sub_data_into",
+     (PyCFunction) OpenVG_vgGetImageSubDataInto,
+     METH_KEYWORDS|METH_VARARGS,
+     OpenVG_vgGetImageSubDataInto__doc__
+    },
     {(char *) "set_sub_data",
      (PyCFunction) OpenVG_vgImageSubData,
      METH_KEYWORDS|METH_VARARGS,
@@ -842,6 +1150,7 @@ PyVGImage__mp_subscript(PyVGImage *self, PyObject *value)
     PyObject *py_retval;
     VGuint key = PyLong_AsUnsignedLong(value);
 
+    backend_wait();
     switch (key) {
         case VG_IMAGE_FORMAT:
             py_retval = PyLong_FromUnsignedLong(vgGetParameteri(self->obj, key));
@@ -856,7 +1165,7 @@ PyVGImage__mp_subscript(PyVGImage *self, PyObject *value)
             return NULL;
     }
 
-    return Py_BuildValue((char *) "N", py_retval);
+    return py_retval;
 }
 
 static int
@@ -864,6 +1173,7 @@ PyVGImage__mp_ass_subscript(PyVGImage *self, PyObject *pykey, PyObject *value)
 {
     VGuint key = (VGImageParamType)PyLong_AsUnsignedLong(pykey);
     
+    backend_wait();
     switch (key) {
         case VG_IMAGE_FORMAT:
             vgSetParameteri(self->obj, key, PyLong_AsUnsignedLong(value));
@@ -897,6 +1207,7 @@ PyVGImage__tp_dealloc(PyVGImage *self)
     if (self->obj) {
         VGImage tmp = self->obj;
         self->obj = NULL;
+        backend_wait();
         vgDestroyImage(tmp);
     }
     Py_TYPE(self)->tp_free((PyObject*)self);
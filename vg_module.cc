@@ -20,40 +20,220 @@
 
 #include "openvg_module.h"
 
-VGErrorCode check_error(void) {
+PyThread_type_lock backend_mutex = NULL;
+int backend_busy = 0;
+unsigned long backend_thread = 0;
+
+/* Wait for backend_mutex without the GIL, then give it back. */
+static void
+backend_wait_mutex(void)
+{
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(backend_mutex, WAIT_LOCK);
+    PyThread_release_lock(backend_mutex);
+    Py_END_ALLOW_THREADS
+}
+
+/*
+ * Take backend_mutex for a call about to release the GIL.  Only
+ * backend_sync() can hold it while the backend is idle, for a moment.
+ */
+void
+backend_acquire(void)
+{
+    backend_wait();
+    while (!PyThread_acquire_lock(backend_mutex, NOWAIT_LOCK)) {
+        backend_wait_mutex();
+        backend_wait();
+    }
+    backend_busy++;
+}
+
+/*
+ * Let the calls running without the GIL finish.  Others may start while
+ * this waits without the GIL; backend_busy also counts the calls that
+ * are done and wait for the GIL, they leave the mutex free.
+ */
+void
+backend_sync(void)
+{
+    while (backend_busy) {
+        if (PyThread_acquire_lock(backend_mutex, NOWAIT_LOCK)) {
+            PyThread_release_lock(backend_mutex);
+            return;
+        }
+        backend_wait_mutex();
+    }
+}
+
+/*
+ * Deferred error checking (VG.defer_errors()): check_error() only
+ * counts calls and errors are picked up at flush(), finish(), the end of
+ * VGContext.execute() and VGContext.check().  OpenVG keeps the first error
+ * raised since the last vgGetError(), but not which call raised it.
+ */
+static bool errors_deferred = false;
+static unsigned long error_calls = 0;       /* wrapped calls so far */
+static unsigned long error_checked = 0;     /* error_calls at the last check */
+
+/*
+ * vgGetError(), preceded by the error kept for the current context while
+ * another thread's context was loaded.  Call after backend_wait().
+ */
+static VGErrorCode
+take_error(void)
+{
+    VGErrorCode kept = context_take_error();
     VGErrorCode error = vgGetError();
 
+    return kept != VG_NO_ERROR ? kept : error;
+}
+
+static void
+raise_error(VGErrorCode error, bool deferred)
+{
+    PyObject *type;
+    const char *name;
+
     switch (error) {
-        case VG_NO_ERROR:
-            break;
         case VG_BAD_HANDLE_ERROR:
-            PyErr_SetString(PyExc_TypeError, "VG_BAD_HANDLE_ERROR");
+            type = PyExc_TypeError;
+            name = "VG_BAD_HANDLE_ERROR";
             break;
         case VG_ILLEGAL_ARGUMENT_ERROR:
-            PyErr_SetString(PyExc_TypeError, "VG_ILLEGAL_ARGUMENT_ERROR");
+            type = PyExc_TypeError;
+            name = "VG_ILLEGAL_ARGUMENT_ERROR";
             break;
         case VG_OUT_OF_MEMORY_ERROR:
-            PyErr_SetString(PyExc_MemoryError, "VG_OUT_OF_MEMORY_ERROR");
+            type = PyExc_MemoryError;
+            name = "VG_OUT_OF_MEMORY_ERROR";
             break;
         case VG_PATH_CAPABILITY_ERROR:
-            PyErr_SetString(PyExc_ValueError, "VG_PATH_CAPABILITY_ERROR");
+            type = PyExc_ValueError;
+            name = "VG_PATH_CAPABILITY_ERROR";
             break;
         case VG_UNSUPPORTED_IMAGE_FORMAT_ERROR:
-            PyErr_SetString(PyExc_ValueError, "VG_UNSUPPORTED_IMAGE_FORMAT_ERROR");
+            type = PyExc_ValueError;
+            name = "VG_UNSUPPORTED_IMAGE_FORMAT_ERROR";
             break;
         case VG_UNSUPPORTED_PATH_FORMAT_ERROR:
-            PyErr_SetString(PyExc_ValueError, "VG_UNSUPPORTED_PATH_FORMAT_ERROR");
+            type = PyExc_ValueError;
+            name = "VG_UNSUPPORTED_PATH_FORMAT_ERROR";
             break;
         case VG_IMAGE_IN_USE_ERROR:
-            PyErr_SetString(PyExc_RuntimeError, "VG_IMAGE_IN_USE_ERROR");
+            type = PyExc_RuntimeError;
+            name = "VG_IMAGE_IN_USE_ERROR";
             break;
         case VG_NO_CONTEXT_ERROR:
-            PyErr_SetString(PyExc_RuntimeError, "VG_NO_CONTEXT_ERROR");
+            type = PyExc_RuntimeError;
+            name = "VG_NO_CONTEXT_ERROR";
             break;
+        default:
+            return;
     }
+
+    if (deferred)
+        PyErr_Format(type, "%s (raised by one of calls %lu-%lu, OpenVG does not record which)",
+                     name, error_checked + 1, error_calls);
+    else
+        PyErr_SetString(type, name);
+}
+
+VGErrorCode check_error(void) {
+    VGErrorCode error;
+
+    error_calls++;
+    if (errors_deferred)
+        return VG_NO_ERROR;
+
+    backend_wait();
+    error = take_error();
+    raise_error(error, false);
+    error_checked = error_calls;
     return error;
 }
 
+/*
+ * Report the error held back since the last check.  Only queries OpenVG
+ * in deferred mode unless `always' is set, strict mode has nothing held.
+ */
+VGErrorCode check_pending_error(bool always) {
+    VGErrorCode error;
+
+    if (!errors_deferred && !always)
+        return VG_NO_ERROR;
+
+    backend_wait();
+    error = take_error();
+    raise_error(error, errors_deferred);
+    error_checked = error_calls;
+    return error;
+}
+
+bool get_errors_deferred(void) {
+    return errors_deferred;
+}
+
+/* leaving deferred mode reports whatever is still pending */
+VGErrorCode set_errors_deferred(bool deferred) {
+    VGErrorCode error = check_pending_error(false);
+
+    errors_deferred = deferred;
+    return error;
+}
+
+/* Bits per pixel of `format'. */
+static Py_ssize_t
+pixel_format_bits(VGImageFormat format)
+{
+    switch (format) {
+        case VG_BW_1:
+            return 1;
+        case VG_sL_8:
+        case VG_lL_8:
+        case VG_A_8:
+            return 8;
+        case VG_sRGB_565:
+        case VG_sRGBA_5551:
+        case VG_sRGBA_4444:
+        case VG_sARGB_1555:
+        case VG_sARGB_4444:
+        case VG_sBGR_565:
+        case VG_sBGRA_5551:
+        case VG_sBGRA_4444:
+        case VG_sABGR_1555:
+        case VG_sABGR_4444:
+            return 16;
+        default:
+            return 32;
+    }
+}
+
+/*
+ * Size in bytes of a `width' x `height' block of `format' pixels whose rows
+ * are `stride' bytes apart.  `offset' receives the position of the first
+ * row within the block, which is the last row for negative (bottom-up)
+ * strides.  Returns -1 with an exception set for an empty region.
+ */
+Py_ssize_t
+pixel_data_size(VGint stride, VGImageFormat format, VGint width, VGint height,
+                Py_ssize_t *offset)
+{
+    Py_ssize_t row, step;
+
+    if (width <= 0 || height <= 0) {
+        PyErr_SetString(PyExc_TypeError, "VG_ILLEGAL_ARGUMENT_ERROR");
+        return -1;
+    }
+
+    row = (pixel_format_bits(format) * width + 7) / 8;
+    step = stride < 0 ? -(Py_ssize_t)stride : stride;
+
+    *offset = stride < 0 ? step * (height - 1) : 0;
+
+    return step * (height - 1) + row;
+}
+
 #if PY_VERSION_HEX >= 0x03000000
 static struct PyModuleDef VGRenderingQuality_moduledef = {
     PyModuleDef_HEAD_INIT,
@@ -1072,6 +1252,7 @@ OpenVG_vgHardwareQuery(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwarg
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "ii", (char **) keywords, &key, &setting)) {
         return NULL;
     }
+    backend_wait();
     retval = vgHardwareQuery(key, setting);
     py_retval = Py_BuildValue((char *) "i", retval);
     return py_retval;
@@ -1088,6 +1269,7 @@ OpenVG_vgGetString(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "i", (char **) keywords, &name)) {
         return NULL;
     }
+    backend_wait();
     retval = vgGetString(name);
     py_retval = Py_BuildValue((char *) "s", retval);
     return py_retval;
@@ -1099,12 +1281,165 @@ OpenVG_vgGetError()
     PyObject *py_retval;
     VGErrorCode retval;
     
-    retval = vgGetError();
+    backend_wait();
+    retval = take_error();
     py_retval = Py_BuildValue((char *) "i", retval);
     return py_retval;
 }
 
 
+PyDoc_STRVAR(OpenVG_DeferErrors__doc__,
+".. function:: defer_errors([deferred])\n"
+"\n"
+"   Turn deferred error checking on or off, for the whole process as\n"
+"   ShivaVG keeps one error state.  While on, calls stop checking for\n"
+"   errors one by one and errors are reported by VGContext.flush(),\n"
+"   finish(), execute() and check() instead.  Values returned between\n"
+"   checks are not validated, and calls that add to a path make it forget\n"
+"   its recorded layout, see VGPath.get_data().  Turning it off reports\n"
+"   any error still pending.\n"
+"\n"
+"   OpenVG keeps only the first error raised since it was last asked, not\n"
+"   which call raised it.  A deferred error therefore names the range of\n"
+"   calls made since the previous check, counted over all the calls the\n"
+"   module checks; any one of them may have raised it.  Check more often\n"
+"   to narrow the range down.\n"
+"\n"
+"   :arg deferred: Defer errors, default True.\n"
+"   :type deferred: bool\n"
+"   :return: Whether errors were deferred before.\n"
+"   :rtype: bool\n"
+);
+
+static PyObject *
+OpenVG_DeferErrors(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+{
+    PyObject *py_deferred = Py_True;
+    bool previous = errors_deferred;
+    int deferred;
+
+    const char *keywords[] = {"deferred", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "|O", (char **) keywords, &py_deferred)) {
+        return NULL;
+    }
+
+    if ((deferred = PyObject_IsTrue(py_deferred)) < 0)
+        return NULL;
+
+    if (set_errors_deferred(deferred))
+        return NULL;
+
+    return PyBool_FromLong(previous);
+}
+
+PyDoc_STRVAR(OpenVG_ConvertPixels__doc__,
+".. function:: convert_pixels(src, srcStride, srcFormat, dst, dstStride, dstFormat, width, height)\n"
+"\n"
+"   Convert a block of pixels between formats without a context.\n"
+"\n"
+"   Handles the 8888 formats in every channel order, the 565 formats,\n"
+"   L_8 and A_8.  `src' and `dst' may only overlap for a conversion in\n"
+"   place: same start, same stride and formats of the same pixel size.\n"
+"\n"
+"   :arg src: Source pixel data.\n"
+"   :type src: bytes, bytearray, memoryview, mmap, ...\n"
+"   :arg srcStride: Stride between source rows.\n"
+"   :type srcStride: int\n"
+"   :arg srcFormat: Source pixel format.\n"
+"   :type srcFormat: VGImageFormat\n"
+"   :arg dst: Destination, any writable contiguous buffer.\n"
+"   :type dst: bytearray, memoryview, mmap, ...\n"
+"   :arg dstStride: Stride between destination rows.\n"
+"   :type dstStride: int\n"
+"   :arg dstFormat: Destination pixel format.\n"
+"   :type dstFormat: VGImageFormat\n"
+"   :arg width: Width of the block.\n"
+"   :type width: int\n"
+"   :arg height: Height of the block.\n"
+"   :type height: int\n"
+"\n"
+"   :error: VG_UNSUPPORTED_IMAGE_FORMAT_ERROR.\n"
+"   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
+);
+
+STATS_ENTRY(stats_ConvertPixels, "convert_pixels");
+
+static PyObject *
+OpenVG_ConvertPixels(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+{
+    PyObject *src, *dst;
+    Py_buffer src_view, dst_view;
+    VGint srcStride, dstStride;
+    VGImageFormat srcFormat, dstFormat;
+    VGint width, height;
+    Py_ssize_t src_bytes, src_offset, dst_bytes, dst_offset;
+    const char *keywords[] = {"src", "srcStride", "srcFormat", "dst", "dstStride", "dstFormat", "width", "height", NULL};
+
+    stats_scope stats(&stats_ConvertPixels);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "OiiOiiii", (char **) keywords,
+                                     &src, &srcStride, &srcFormat,
+                                     &dst, &dstStride, &dstFormat,
+                                     &width, &height)) {
+        return NULL;
+    }
+
+    if (!pixel_convert_supported(srcFormat) || !pixel_convert_supported(dstFormat)) {
+        PyErr_SetString(PyExc_ValueError, "VG_UNSUPPORTED_IMAGE_FORMAT_ERROR");
+        return NULL;
+    }
+
+    if ((src_bytes = pixel_data_size(srcStride, srcFormat, width, height, &src_offset)) < 0 ||
+        (dst_bytes = pixel_data_size(dstStride, dstFormat, width, height, &dst_offset)) < 0)
+        return NULL;
+    stats.bytes = src_bytes + dst_bytes;
+
+    if (PyObject_GetBuffer(src, &src_view, PyBUF_C_CONTIGUOUS) < 0)
+        return NULL;
+
+    if (PyObject_GetBuffer(dst, &dst_view, PyBUF_WRITABLE) < 0) {
+        PyBuffer_Release(&src_view);
+        return NULL;
+    }
+
+    if (src_view.len < src_bytes || dst_view.len < dst_bytes) {
+        PyErr_Format(PyExc_ValueError,
+                     "convert_pixels(): %s holds %zd bytes, %zd needed",
+                     src_view.len < src_bytes ? "src" : "dst",
+                     src_view.len < src_bytes ? src_view.len : dst_view.len,
+                     src_view.len < src_bytes ? src_bytes : dst_bytes);
+        PyBuffer_Release(&dst_view);
+        PyBuffer_Release(&src_view);
+        return NULL;
+    }
+
+    /* only converting in place, pixel for same-size pixel, is safe */
+    if ((char *)src_view.buf < (char *)dst_view.buf + dst_bytes &&
+        (char *)dst_view.buf < (char *)src_view.buf + src_bytes &&
+        ((char *)src_view.buf + src_offset != (char *)dst_view.buf + dst_offset ||
+         srcStride != dstStride ||
+         pixel_format_bits(srcFormat) != pixel_format_bits(dstFormat))) {
+        PyErr_SetString(PyExc_ValueError,
+                        "convert_pixels(): src and dst overlap");
+        PyBuffer_Release(&dst_view);
+        PyBuffer_Release(&src_view);
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    pixel_convert((char *)src_view.buf + src_offset, srcStride, srcFormat,
+                  (char *)dst_view.buf + dst_offset, dstStride, dstFormat,
+                  width, height);
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&dst_view);
+    PyBuffer_Release(&src_view);
+
+    Py_RETURN_NONE;
+}
+
+
 static PyMethodDef OpenVG_functions[] = {
     {(char *) "hardware_query",
      (PyCFunction) OpenVG_vgHardwareQuery,
@@ -1121,6 +1456,56 @@ static PyMethodDef OpenVG_functions[] = {
      METH_NOARGS,
      NULL
     },
+    {(char *) "defer_errors",
+     (PyCFunction) OpenVG_DeferErrors,
+     METH_KEYWORDS|METH_VARARGS,
+     OpenVG_DeferErrors__doc__
+    },
+    {(char *) "convert_pixels",
+     (PyCFunction) OpenVG_ConvertPixels,
+     METH_KEYWORDS|METH_VARARGS,
+     OpenVG_ConvertPixels__doc__
+    },
+    {(char *) "save_paths",
+     (PyCFunction) OpenVG_SavePaths,
+     METH_KEYWORDS|METH_VARARGS,
+     OpenVG_SavePaths__doc__
+    },
+    {(char *) "load_paths",
+     (PyCFunction) OpenVG_LoadPaths,
+     METH_KEYWORDS|METH_VARARGS,
+     OpenVG_LoadPaths__doc__
+    },
+    {(char *) "stats",
+     (PyCFunction) OpenVG_Stats,
+     METH_NOARGS,
+     OpenVG_Stats__doc__
+    },
+    {(char *) "reset_stats",
+     (PyCFunction) OpenVG_ResetStats,
+     METH_NOARGS,
+     OpenVG_ResetStats__doc__
+    },
+    {(char *) "enable_stats",
+     (PyCFunction) OpenVG_EnableStats,
+     METH_KEYWORDS|METH_VARARGS,
+     OpenVG_EnableStats__doc__
+    },
+    {(char *) "start_trace",
+     (PyCFunction) OpenVG_StartTrace,
+     METH_KEYWORDS|METH_VARARGS,
+     OpenVG_StartTrace__doc__
+    },
+    {(char *) "stop_trace",
+     (PyCFunction) OpenVG_StopTrace,
+     METH_NOARGS,
+     OpenVG_StopTrace__doc__
+    },
+    {(char *) "dump_trace",
+     (PyCFunction) OpenVG_DumpTrace,
+     METH_KEYWORDS|METH_VARARGS,
+     OpenVG_DumpTrace__doc__
+    },
     {NULL, NULL, 0, NULL}
 };
 
@@ -1149,6 +1534,14 @@ initVG(void)
         return NULL;
     }
 
+    pixel_convert_init();
+
+    backend_mutex = PyThread_allocate_lock();
+    if (backend_mutex == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+
     /* Register the 'VGPath' class */
     if (PyType_Ready(&PyVGPath_Type)) {
         return NULL;
@@ -1173,6 +1566,24 @@ initVG(void)
     }
     PyModule_AddObject(m, (char *) "VGContext", (PyObject *) &PyVGContext_Type);
 
+    /* Register the 'VGDisplayList' class */
+    if (PyType_Ready(&PyVGDisplayList_Type)) {
+        return NULL;
+    }
+    PyModule_AddObject(m, (char *) "VGDisplayList", (PyObject *) &PyVGDisplayList_Type);
+
+    /* Register the 'VGRenderTarget' class */
+    if (PyType_Ready(&PyVGRenderTarget_Type)) {
+        return NULL;
+    }
+    PyModule_AddObject(m, (char *) "VGRenderTarget", (PyObject *) &PyVGRenderTarget_Type);
+
+    /* Register the 'VGGlyphCache' class */
+    if (PyType_Ready(&PyVGGlyphCache_Type)) {
+        return NULL;
+    }
+    PyModule_AddObject(m, (char *) "VGGlyphCache", (PyObject *) &PyVGGlyphCache_Type);
+
     submodule = initOpenVG_VGRenderingQuality();
     if (submodule == NULL) {
         return NULL;
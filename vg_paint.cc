@@ -25,7 +25,8 @@ PyVGPaint__get_color(PyVGPaint *self, void * UNUSED(closure))
 {
     PyObject *py_retval;
     
-    py_retval = Py_BuildValue((char *) "N", PyLong_FromUnsignedLong(vgGetColor(self->obj)));
+    backend_wait();
+    py_retval = PyLong_FromUnsignedLong(vgGetColor(self->obj));
 
     if (check_error()) {
         Py_DECREF(py_retval);
@@ -38,16 +39,17 @@ PyVGPaint__get_color(PyVGPaint *self, void * UNUSED(closure))
 static int
 PyVGPaint__set_color(PyVGPaint *self, PyObject *value, void * UNUSED(closure))
 {
-    PyObject *py_retval;
-    VGuint tmp_value;
-    
-    py_retval = Py_BuildValue((char *) "(O)", value);
-    if (!PyArg_ParseTuple(py_retval, (char *) "I", &tmp_value)) {
-        Py_DECREF(py_retval);
+    VGbitfield color;
+
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError, "cannot delete attribute");
         return -1;
     }
-    vgSetColor(self->obj, tmp_value);
-    Py_DECREF(py_retval);
+    if (!fast_bitfield(value, &color))
+        return -1;
+
+    backend_wait();
+    vgSetColor(self->obj, color);
 
     return check_error() ? -1 : 0;
 }
@@ -80,6 +82,7 @@ PyVGPaint__tp_init(PyVGPaint *self, PyObject *args, PyObject *kwargs)
         return -1;
     }
 
+    backend_wait();
     if ((self->obj = vgCreatePaint()) == VG_INVALID_HANDLE)
         return -1;
 
@@ -100,16 +103,21 @@ PyDoc_STRVAR(OpenVG_vgPaintPattern__doc__,
 "   :error: VG_IMAGE_IN_USE_ERROR.\n"
 );
 
+static const char *const OpenVG_vgPaintPattern_keywords[] = {"pattern", NULL};
+static const struct fast_parser OpenVG_vgPaintPattern_parser = {"pattern", OpenVG_vgPaintPattern_keywords, 1, 1};
+
 static PyObject *
-OpenVG_vgPaintPattern(PyVGPaint *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgPaintPattern(PyVGPaint *self, FAST_ARGS)
 {
+    PyObject *argv[1];
     PyObject *pattern;
-    const char *keywords[] = {"pattern", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O", (char **) keywords, &pattern)) {
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgPaintPattern_parser, argv)) {
         return NULL;
     }
+    pattern = argv[0];
 
+    backend_wait();
     if (PyObject_TypeCheck(pattern, &PyVGImage_Type))
         vgPaintPattern(self->obj, ((PyVGImage*)pattern)->obj);
     else if (pattern == Py_None)
@@ -130,7 +138,7 @@ OpenVG_vgPaintPattern(PyVGPaint *self, PyObject *args, PyObject *kwargs)
 static PyMethodDef PyVGPaint_methods[] = {
     {(char *) "pattern",
      (PyCFunction) OpenVG_vgPaintPattern,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgPaintPattern__doc__
     },
     {NULL, NULL, 0, NULL}
@@ -142,6 +150,7 @@ PyVGPaint__mp_subscript(PyVGPaint *self, PyObject *value)
     PyObject *py_retval = NULL;
     VGuint key = PyLong_AsUnsignedLong(value);
 
+    backend_wait();
     switch (key) {
         case VG_PAINT_TYPE:
         case VG_PAINT_COLOR_RAMP_SPREAD_MODE:
@@ -182,7 +191,7 @@ PyVGPaint__mp_subscript(PyVGPaint *self, PyObject *value)
         return NULL;
     }
 
-    return Py_BuildValue((char *) "N", py_retval);
+    return py_retval;
 }
 
 static int
@@ -190,6 +199,7 @@ PyVGPaint__mp_ass_subscript(PyVGPaint *self, PyObject *pykey, PyObject *value)
 {
     VGuint key = PyLong_AsUnsignedLong(pykey);
     
+    backend_wait();
     switch (key) {
         case VG_PAINT_TYPE:
         case VG_PAINT_COLOR_RAMP_SPREAD_MODE:
@@ -248,6 +258,7 @@ PyVGPaint__tp_dealloc(PyVGPaint *self)
     if (self->obj) {
         VGPaint tmp = self->obj;
         self->obj = NULL;
+        backend_wait();
         vgDestroyPaint(tmp);
     }
 
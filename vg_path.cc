@@ -19,6 +19,7 @@
  */
 
 #include "openvg_module.h"
+#include <limits.h>
 
 PyDoc_STRVAR(PyVGPath_paint_modes__doc__,
 ".. attribute:: paint_stroke\n"
@@ -29,24 +30,20 @@ PyDoc_STRVAR(PyVGPath_paint_modes__doc__,
 static PyObject*
 PyVGPath__get_paint_modes(PyVGPath *self, void * UNUSED(closure))
 {
-    return Py_BuildValue((char *) "N",
-                         PyLong_FromUnsignedLong(self->paint_modes));
+    return PyLong_FromUnsignedLong(self->paint_modes);
 }
 
 static int
 PyVGPath__set_paint_modes(PyVGPath *self, PyObject *value, void * UNUSED(closure))
 {
-    PyObject *py_retval;
-    unsigned int modes;
-
-    py_retval = Py_BuildValue((char *) "(O)", value);
+    VGbitfield modes;
 
-    if (!PyArg_ParseTuple(py_retval, (char *) "I", &modes)) {
-        Py_DECREF(py_retval);
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError, "cannot delete attribute");
         return -1;
     }
-
-    Py_DECREF(py_retval);
+    if (!fast_bitfield(value, &modes))
+        return -1;
 
     if (modes & (~(VG_STROKE_PATH | VG_FILL_PATH))) {
         PyErr_SetString(PyExc_TypeError, "VG_ILLEGAL_ARGUMENT_ERROR");
@@ -57,6 +54,72 @@ PyVGPath__set_paint_modes(PyVGPath *self, PyObject *value, void * UNUSED(closure
 
     return 0;
 }
+
+PyDoc_STRVAR(PyVGPath_tessellation_tolerance__doc__,
+".. attribute:: tessellation_tolerance\n"
+"\n"
+"   Enables the tessellation cache when above 0.  draw() then flattens\n"
+"   the curves of the path into lines at most this many surface pixels\n"
+"   off, and keeps drawing the flattened copy while the scale of the\n"
+"   path-user-to-surface matrix stays within tessellation_band.  Only\n"
+"   paths whose data all came from append_data(), append() or\n"
+"   modify_coords() are cached; others are drawn as they are.  Without\n"
+"   VG_PATH_CAPABILITY_APPEND_FROM the coordinates are only kept while\n"
+"   this is set, so set it before appending.\n"
+"\n"
+"   Only draw() uses the cache.  VGContext.draw_paths(), the replay of\n"
+"   VGDisplayList.draw_path() and VGGlyphCache.draw_glyph_run() draw the\n"
+"   path itself, which ShivaVG retessellates whenever the scale changes.\n"
+"\n"
+"   :type float: Tolerance in pixels, 0 (disabled) by default.\n"
+);
+
+PyDoc_STRVAR(PyVGPath_tessellation_band__doc__,
+".. attribute:: tessellation_band\n"
+"\n"
+"   The cached tessellation is reused for scales between the scale it was\n"
+"   made for divided and multiplied by this factor.\n"
+"\n"
+"   :type float: Factor >= 1, 2.0 by default.\n"
+);
+
+static PyObject*
+PyVGPath__get_tessellation(PyVGPath *self, void *closure)
+{
+    return PyFloat_FromDouble(closure ? self->flat_band : self->flat_tolerance);
+}
+
+static int
+PyVGPath__set_tessellation(PyVGPath *self, PyObject *value, void *closure)
+{
+    double number;
+
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError, "cannot delete tessellation attributes");
+        return -1;
+    }
+
+    number = PyFloat_AsDouble(value);
+    if (number == -1.0 && PyErr_Occurred())
+        return -1;
+
+    if (closure ? !(number >= 1.0) : !(number >= 0.0)) {
+        PyErr_SetString(PyExc_ValueError, closure ?
+                        "tessellation_band must be >= 1" :
+                        "tessellation_tolerance must be >= 0");
+        return -1;
+    }
+
+    if (closure)
+        self->flat_band = (VGfloat)number;
+    else
+        self->flat_tolerance = (VGfloat)number;
+
+    path_invalidate_tessellation(self);
+    path_release_coords(self);
+    return 0;
+}
+
 static PyGetSetDef PyVGPath__getsets[] = {
     {
         (char*) "paint_modes", /* attribute name */
@@ -65,10 +128,529 @@ static PyGetSetDef PyVGPath__getsets[] = {
         PyVGPath_paint_modes__doc__, /* optional doc string */
         NULL /* optional additional data for getter and setter */
     },
+    {
+        (char*) "tessellation_band", /* attribute name */
+        (getter) PyVGPath__get_tessellation, /* C function to get the attribute */
+        (setter) PyVGPath__set_tessellation, /* C function to set the attribute */
+        PyVGPath_tessellation_band__doc__, /* optional doc string */
+        (void *) "band" /* optional additional data for getter and setter */
+    },
+    {
+        (char*) "tessellation_tolerance", /* attribute name */
+        (getter) PyVGPath__get_tessellation, /* C function to get the attribute */
+        (setter) PyVGPath__set_tessellation, /* C function to set the attribute */
+        PyVGPath_tessellation_tolerance__doc__, /* optional doc string */
+        NULL /* optional additional data for getter and setter */
+    },
     { NULL, NULL, NULL, NULL, NULL }
 };
 
 
+/* Size in bytes of a single coordinate of `type'. */
+int
+path_datatype_size(VGPathDatatype type)
+{
+    switch (type) {
+        case VG_PATH_DATATYPE_S_8:
+            return sizeof(VGbyte);
+        case VG_PATH_DATATYPE_S_16:
+            return sizeof(VGshort);
+        case VG_PATH_DATATYPE_S_32:
+            return sizeof(VGint);
+        case VG_PATH_DATATYPE_F:
+            return sizeof(VGfloat);
+    }
+    return 0;
+}
+
+/* Number of coordinates taken by `segment', or -1 if it is invalid. */
+int
+path_segment_coords(VGubyte segment)
+{
+    switch (segment & ~VG_RELATIVE) {
+        case VG_CLOSE_PATH:
+            return 0;
+        case VG_HLINE_TO:
+        case VG_VLINE_TO:
+            return 1;
+        case VG_MOVE_TO:
+        case VG_LINE_TO:
+        case VG_SQUAD_TO:
+            return 2;
+        case VG_QUAD_TO:
+        case VG_SCUBIC_TO:
+            return 4;
+        case VG_SCCWARC_TO:
+        case VG_SCWARC_TO:
+        case VG_LCCWARC_TO:
+        case VG_LCWARC_TO:
+            return 5;
+        case VG_CUBIC_TO:
+            return 6;
+    }
+    return -1;
+}
+
+/* Room for `count' more items in an array of `max' holding `num' of them. */
+static bool
+path_reserve(void **array, VGint num, VGint *max, VGint count, size_t itemsize)
+{
+    Py_ssize_t needed = (Py_ssize_t)num + count, size;
+    void *tmp;
+
+    if (needed <= *max)
+        return true;
+
+    if (needed > INT_MAX)
+        return false;
+
+    size = needed > INT_MAX / 2 ? needed : needed * 2;
+    if ((size_t)size > PY_SSIZE_T_MAX / itemsize)
+        return false;
+
+    tmp = PyMem_Realloc(*array, size * itemsize);
+    if (tmp == NULL)
+        return false;
+
+    *array = tmp;
+    *max = (VGint)size;
+    return true;
+}
+
+/*
+ * OpenVG has no way to query the segment commands of a path, but
+ * modify_coords() needs them to know how many coordinates a range of
+ * segments takes.  Every call that adds segments through these bindings
+ * records them here; when a backend call appends something we can't
+ * predict, the layout is marked unknown (num_segments == -1).
+ */
+void
+path_record_segments(PyVGPath *path, const VGubyte *segments, VGint count)
+{
+    path_invalidate_tessellation(path);
+
+    if (path->num_segments < 0 || count <= 0)
+        return;
+
+    if (!path_reserve((void **)&path->segments, path->num_segments,
+                      &path->max_segments, count, 1)) {
+        path_forget_segments(path);
+        return;
+    }
+
+    memcpy(path->segments + path->num_segments, segments, count);
+    path->num_segments += count;
+}
+
+/* Forget the recorded layout if it disagrees with the backend. */
+void
+path_verify_segments(PyVGPath *path)
+{
+    VGint idx, coords = 0;
+
+    if (path->num_segments < 0)
+        return;
+
+    for (idx = 0; idx < path->num_segments; idx++) {
+        coords += path_segment_coords(path->segments[idx]);
+    }
+
+    backend_wait();
+    if (vgGetParameteri(path->obj, VG_PATH_NUM_SEGMENTS) != path->num_segments ||
+        vgGetParameteri(path->obj, VG_PATH_NUM_COORDS) != coords) {
+        path_forget_segments(path);
+    }
+    /* the queries above must not leave an error behind, unless errors are
+       deferred where that would also swallow the pending one */
+    if (!get_errors_deferred())
+        vgGetError();
+}
+
+void
+path_forget_segments(PyVGPath *path)
+{
+    path_invalidate_tessellation(path);
+    PyMem_Free(path->segments);
+    path->segments = NULL;
+    path->num_segments = -1;
+    path->max_segments = 0;
+    PyMem_Free(path->data);
+    path->data = NULL;
+    path->num_coords = 0;
+    path->max_coords = 0;
+    path->coord_segments = 0;
+}
+
+/*
+ * With deferred errors a call that failed goes unnoticed until the next
+ * check, so what it would have added to `path' can't be recorded: the
+ * layout is forgotten instead.  True when it was.
+ */
+bool
+path_forget_unchecked(PyVGPath *path)
+{
+    if (!get_errors_deferred())
+        return false;
+
+    path_forget_segments(path);
+    return true;
+}
+
+static void
+path_clear_segments(PyVGPath *path)
+{
+    path_forget_segments(path);
+    path->num_segments = 0;
+}
+
+/*
+ * The coordinates are recorded next to the segments, as the bytes handed
+ * to the backend in the path's datatype, for the tessellation cache and
+ * for get_data().  They are only kept while one of them may use them,
+ * and only cover the path while every segment was added with known data:
+ * anything else, like the VGU functions, adds segments without
+ * coordinates and leaves `coord_segments' behind for good.
+ */
+bool
+path_coords_known(PyVGPath *path)
+{
+    return path->num_segments >= 0 && path->coord_segments == path->num_segments;
+}
+
+static bool
+path_wants_coords(PyVGPath *path)
+{
+    return path->flat_tolerance > 0.0f ||
+        (path->capabilities & VG_PATH_CAPABILITY_APPEND_FROM);
+}
+
+/* Drop the recorded coordinates nothing uses any more, for good. */
+void
+path_release_coords(PyVGPath *path)
+{
+    if (path_wants_coords(path))
+        return;
+
+    PyMem_Free(path->data);
+    path->data = NULL;
+    path->num_coords = 0;
+    path->max_coords = 0;
+    if (path->coord_segments > 0)
+        path->coord_segments = -1;
+}
+
+/* Record `count' coordinates in the path's datatype for the last `segments' segments. */
+void
+path_record_data(PyVGPath *path, const void *data, VGint count, VGint segments)
+{
+    int size = path_datatype_size(path->datatype);
+
+    if (path->num_segments < 0 || path->coord_segments != path->num_segments - segments)
+        return;
+
+    if (!path_wants_coords(path) || size == 0 ||
+        !path_reserve(&path->data, path->num_coords, &path->max_coords, count, size)) {
+        /* stays behind, the coordinates are unknown from now on */
+        return;
+    }
+
+    if (count > 0)
+        memcpy((char *)path->data + (size_t)path->num_coords * size, data, (size_t)count * size);
+    path->num_coords += count;
+    path->coord_segments += segments;
+}
+
+/* Convert `count' values of `type' to user units. */
+void
+path_data_to_user(const void *data, VGPathDatatype type, VGfloat scale, VGfloat bias,
+                  VGfloat *out, Py_ssize_t count)
+{
+    Py_ssize_t idx;
+
+    for (idx = 0; idx < count; idx++) {
+        VGfloat value = 0.0f;
+
+        switch (type) {
+            case VG_PATH_DATATYPE_S_8:
+                value = ((const VGbyte *)data)[idx];
+                break;
+            case VG_PATH_DATATYPE_S_16:
+                value = ((const VGshort *)data)[idx];
+                break;
+            case VG_PATH_DATATYPE_S_32:
+                value = (VGfloat)((const VGint *)data)[idx];
+                break;
+            case VG_PATH_DATATYPE_F:
+                value = ((const VGfloat *)data)[idx];
+                break;
+        }
+        out[idx] = value * scale + bias;
+    }
+}
+
+/* Convert `count' user units to `type', false if one is out of range. */
+bool
+path_user_to_data(const VGfloat *user, VGPathDatatype type, VGfloat scale, VGfloat bias,
+                  void *out, Py_ssize_t count)
+{
+    Py_ssize_t idx;
+
+    for (idx = 0; idx < count; idx++) {
+        double value = ((double)user[idx] - bias) / scale;
+
+        if (type != VG_PATH_DATATYPE_F)
+            value = floor(value + 0.5);
+
+        switch (type) {
+            case VG_PATH_DATATYPE_S_8:
+                if (value < -128.0 || value > 127.0)
+                    return false;
+                ((VGbyte *)out)[idx] = (VGbyte)value;
+                break;
+            case VG_PATH_DATATYPE_S_16:
+                if (value < -32768.0 || value > 32767.0)
+                    return false;
+                ((VGshort *)out)[idx] = (VGshort)value;
+                break;
+            case VG_PATH_DATATYPE_S_32:
+                if (value < -2147483648.0 || value > 2147483647.0)
+                    return false;
+                ((VGint *)out)[idx] = (VGint)value;
+                break;
+            case VG_PATH_DATATYPE_F:
+                ((VGfloat *)out)[idx] = (VGfloat)value;
+                break;
+        }
+    }
+    return true;
+}
+
+/*
+ * Skips the byte order character of a struct module `format' if it is the
+ * native one, returns NULL if it is not.
+ */
+static const char *
+path_native_format(const char *format)
+{
+    if (format == NULL)
+        return NULL;
+
+    switch (*format) {
+        case '@':
+        case '=':
+            return format + 1;
+        case '<':
+            return PY_LITTLE_ENDIAN ? format + 1 : NULL;
+        case '>':
+        case '!':
+            return PY_LITTLE_ENDIAN ? NULL : format + 1;
+    }
+    return format;
+}
+
+/* Does the struct module `format' describe values of `type'? */
+static bool
+path_format_matches(const char *format, VGPathDatatype type)
+{
+    if ((format = path_native_format(format)) == NULL)
+        return false;
+
+    if (format[0] == '\0' || format[1] != '\0')
+        return false;
+
+    switch (type) {
+        case VG_PATH_DATATYPE_S_8:
+            return *format == 'b';
+        case VG_PATH_DATATYPE_S_16:
+            return *format == 'h';
+        case VG_PATH_DATATYPE_S_32:
+            return *format == 'i' || (*format == 'l' && sizeof(long) == 4);
+        case VG_PATH_DATATYPE_F:
+            return *format == 'f';
+    }
+    return false;
+}
+
+/*
+ * Lists are converted into a temporary array owned by the view (view->obj
+ * is NULL), anything else must export a C-contiguous buffer.  Path data is
+ * used in place unless it is not aligned for its datatype; segments are
+ * always copied, as their count is checked against the data before the
+ * GIL is released and another thread could change them while ShivaVG
+ * reads them.  Either way the view must be given back with
+ * path_buffer_release().
+ */
+static void
+path_buffer_release(Py_buffer *view)
+{
+    if (view->obj == NULL)
+        PyMem_Free(view->buf);
+    else
+        PyBuffer_Release(view);
+}
+
+static int
+path_segments_acquire(PyObject *obj, Py_buffer *view)
+{
+    Py_buffer source;
+    VGubyte *copy;
+
+    if (PyList_Check(obj)) {
+        Py_ssize_t idx, count = PyList_GET_SIZE(obj);
+        VGubyte *segments = (VGubyte *)PyMem_Malloc(count ? count : 1);
+
+        if (segments == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        for (idx = 0; idx < count; idx++) {
+            segments[idx] = (VGubyte) PyLong_AsUnsignedLong(PyList_GET_ITEM(obj, idx));
+        }
+        if (PyErr_Occurred()) {
+            PyMem_Free(segments);
+            return -1;
+        }
+        PyBuffer_FillInfo(view, NULL, segments, count, 1, PyBUF_SIMPLE);
+        return 0;
+    }
+
+    if (PyObject_GetBuffer(obj, &source, PyBUF_C_CONTIGUOUS) < 0)
+        return -1;
+
+    if (source.itemsize != 1) {
+        PyBuffer_Release(&source);
+        PyErr_SetString(PyExc_TypeError,
+                        "Parameter `pathSegments' must have an itemsize of 1");
+        return -1;
+    }
+
+    if ((copy = (VGubyte *)PyMem_Malloc(source.len ? source.len : 1)) == NULL) {
+        PyBuffer_Release(&source);
+        PyErr_NoMemory();
+        return -1;
+    }
+    memcpy(copy, source.buf, source.len);
+    PyBuffer_FillInfo(view, NULL, copy, source.len, 1, PyBUF_SIMPLE);
+    PyBuffer_Release(&source);
+    return 0;
+}
+
+/* Returns the number of coordinates in `view' or -1 on error. */
+static Py_ssize_t
+path_data_acquire(PyObject *obj, VGPathDatatype type, Py_buffer *view)
+{
+    int size = path_datatype_size(type);
+
+    if (size == 0) {
+        PyErr_SetString(PyExc_ValueError, "VG_UNSUPPORTED_PATH_FORMAT_ERROR");
+        return -1;
+    }
+
+    if (PyList_Check(obj)) {
+        Py_ssize_t idx, count = PyList_GET_SIZE(obj);
+        void *data = PyMem_Malloc(count ? size * count : 1);
+
+        if (data == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        for (idx = 0; idx < count; idx++) {
+            PyObject *element = PyList_GET_ITEM(obj, idx);
+            switch (type) {
+                case VG_PATH_DATATYPE_S_8:
+                    ((VGbyte *)data)[idx] = (VGbyte) PyLong_AsLong(element);
+                    break;
+                case VG_PATH_DATATYPE_S_16:
+                    ((VGshort *)data)[idx] = (VGshort) PyLong_AsLong(element);
+                    break;
+                case VG_PATH_DATATYPE_S_32:
+                    ((VGint *)data)[idx] = (VGint) PyLong_AsLong(element);
+                    break;
+                case VG_PATH_DATATYPE_F:
+                    ((VGfloat *)data)[idx] = (VGfloat) PyFloat_AsDouble(element);
+                    break;
+            }
+        }
+        if (PyErr_Occurred()) {
+            PyMem_Free(data);
+            return -1;
+        }
+        PyBuffer_FillInfo(view, NULL, data, size * count, 1, PyBUF_SIMPLE);
+        return count;
+    }
+
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+        return -1;
+
+    /* raw bytes are taken as already packed in the path's datatype */
+    if (!(view->itemsize == 1 && view->format && strcmp(view->format, "B") == 0 &&
+          view->len % size == 0) &&
+        !(view->itemsize == size && path_format_matches(view->format, type))) {
+        PyBuffer_Release(view);
+        PyErr_SetString(PyExc_TypeError,
+                        "Parameter `pathData' does not match the path's VG_PATH_DATATYPE");
+        return -1;
+    }
+
+    /* slices of bytes need not be aligned for the datatype, ShivaVG reads
+       the coordinates as VGshort, VGint or VGfloat */
+    if ((uintptr_t)view->buf % size != 0) {
+        Py_buffer source = *view;
+        void *data = PyMem_Malloc(source.len ? source.len : 1);
+
+        if (data == NULL) {
+            PyBuffer_Release(&source);
+            PyErr_NoMemory();
+            return -1;
+        }
+        memcpy(data, source.buf, source.len);
+        PyBuffer_FillInfo(view, NULL, data, source.len, 1, PyBUF_SIMPLE);
+        PyBuffer_Release(&source);
+    }
+    return view->len / size;
+}
+
+
+static int
+path_init(PyVGPath *self, VGint pathFormat, VGPathDatatype datatype,
+          VGfloat scale, VGfloat bias, VGint segmentCapacityHint,
+          VGint coordCapacityHint, VGbitfield capabilities)
+{
+    self->paint_modes = VG_FILL_PATH | VG_STROKE_PATH;
+    self->capabilities = capabilities;
+    self->datatype = datatype;
+    self->scale = scale;
+    self->bias = bias;
+    self->flat_band = 2.0f;
+    path_clear_segments(self);
+
+    backend_wait();
+    self->obj = vgCreatePath(pathFormat, datatype, scale, bias,
+                             segmentCapacityHint, coordCapacityHint,
+                             capabilities);
+
+    return check_error() ? -1 : 0;
+}
+
+/* A new VGPath of the standard format, or NULL with an exception set. */
+PyVGPath *
+path_create(VGPathDatatype datatype, VGfloat scale, VGfloat bias,
+            VGint segmentCapacityHint, VGint coordCapacityHint,
+            VGbitfield capabilities)
+{
+    PyVGPath *path = (PyVGPath *)PyVGPath_Type.tp_alloc(&PyVGPath_Type, 0);
+
+    if (path == NULL)
+        return NULL;
+
+    if (path_init(path, VG_PATH_FORMAT_STANDARD, datatype, scale, bias,
+                  segmentCapacityHint, coordCapacityHint, capabilities) < 0) {
+        Py_DECREF(path);
+        return NULL;
+    }
+    return path;
+}
+
 static int
 PyVGPath__tp_init(PyVGPath *self, PyObject *args, PyObject *kwargs)
 {
@@ -91,14 +673,8 @@ PyVGPath__tp_init(PyVGPath *self, PyObject *args, PyObject *kwargs)
         return -1;
     }
 
-    self->paint_modes = VG_FILL_PATH | VG_STROKE_PATH;
-    self->capabilities = capabilities;
-
-    self->obj = vgCreatePath(pathFormat, datatype, scale, bias,
-                             segmentCapacityHint, coordCapacityHint,
-                             capabilities);
-
-    return check_error() ? -1 : 0;
+    return path_init(self, pathFormat, datatype, scale, bias,
+                     segmentCapacityHint, coordCapacityHint, capabilities);
 }
 
 static PyObject *
@@ -109,151 +685,658 @@ PyVGPath__enter__(PyVGPath *self)
                         "VGPath.__enter__(): VGPath not properly constructed.");
         return NULL;
     }
-
-    Py_INCREF(self);
-    return (PyObject *)self;
+
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+static PyObject *
+PyVGPath__exit__(PyVGPath *self, PyObject *args)
+{
+    PyObject *py_retval = PyObject_CallMethod((PyObject *)self, (char *)"draw", NULL);
+
+    if (!py_retval)
+        return NULL;
+
+    Py_DECREF(py_retval);
+
+    Py_RETURN_NONE;
+}
+
+
+PyDoc_STRVAR(OpenVG_vgAppendPath__doc__,
+".. function:: append(srcPath)\n"
+"\n"
+"   Append data from `srcPath'.\n"
+"\n"
+"   :arg srcPath: Source path.\n"
+"   :type srcPath: VGPath.\n"
+"\n"
+"   :error: VG_BAD_HANDLE_ERROR.\n"
+"   :error: VG_PATH_CAPABILITY_ERROR.\n"
+);
+
+STATS_ENTRY(stats_vgAppendPath, "VGPath.append");
+
+static const char *const OpenVG_vgAppendPath_keywords[] = {"srcPath", NULL};
+static const struct fast_parser OpenVG_vgAppendPath_parser = {"append", OpenVG_vgAppendPath_keywords, 1, 1};
+
+static PyObject *
+OpenVG_vgAppendPath(PyVGPath *self, FAST_ARGS)
+{
+    PyObject *argv[1];
+    PyVGPath *srcPath;
+    const VGubyte *segments;
+    VGubyte *segments_copy = NULL;
+    void *data = NULL;
+    VGint num_segments, num_coords;
+    int size;
+
+    stats_scope stats(&stats_vgAppendPath);
+    stats.handle = self->obj;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgAppendPath_parser, argv) ||
+        !fast_object(argv[0], &PyVGPath_Type, &srcPath)) {
+        return NULL;
+    }
+
+    VG_BEGIN_ALLOW_THREADS
+    vgAppendPath(self->obj, srcPath->obj);
+    VG_END_ALLOW_THREADS
+
+    if (check_error())
+        return NULL;
+
+    if (path_forget_unchecked(self) || srcPath->num_segments < 0) {
+        path_forget_segments(self);
+        Py_RETURN_NONE;
+    }
+
+    /*
+     * p.append(p): recording grows the arrays being read, so both are
+     * copied before.  The backend converts the coordinates to the datatype
+     * of self, they are only recorded where that is exact.
+     */
+    num_segments = srcPath->num_segments;
+    num_coords = srcPath->num_coords;
+    size = path_datatype_size(srcPath->datatype);
+
+    if (path_coords_known(srcPath)) {
+        if (srcPath->datatype == self->datatype &&
+            srcPath->scale == self->scale && srcPath->bias == self->bias) {
+            data = PyMem_Malloc(num_coords ? (size_t)num_coords * size : 1);
+            if (data != NULL)
+                memcpy(data, srcPath->data, (size_t)num_coords * size);
+        }
+        else if (self->datatype == VG_PATH_DATATYPE_F &&
+                 self->scale == 1.0f && self->bias == 0.0f) {
+            data = PyMem_New(VGfloat, num_coords ? num_coords : 1);
+            if (data != NULL)
+                path_data_to_user(srcPath->data, srcPath->datatype, srcPath->scale,
+                                  srcPath->bias, (VGfloat *)data, num_coords);
+        }
+    }
+
+    segments = srcPath->segments;
+    if (srcPath == self) {
+        segments = segments_copy = (VGubyte *)PyMem_Malloc(num_segments ? num_segments : 1);
+        if (segments_copy == NULL) {
+            PyMem_Free(data);
+            path_forget_segments(self);
+            Py_RETURN_NONE;
+        }
+        memcpy(segments_copy, srcPath->segments, num_segments);
+    }
+
+    path_record_segments(self, segments, num_segments);
+    if (data != NULL)
+        path_record_data(self, data, num_coords, num_segments);
+
+    PyMem_Free(segments_copy);
+    PyMem_Free(data);
+
+    Py_RETURN_NONE;
+}
+
+
+PyDoc_STRVAR(OpenVG_vgAppendPathData__doc__,
+".. function:: append_data(numSegments, pathSegments, pathData)\n"
+"\n"
+"   Append data from `pathData'.\n"
+"\n"
+"   A `pathData' buffer is handed to OpenVG without copying, the segments\n"
+"   are copied first.  `pathSegments' must have an itemsize of 1 and\n"
+"   `pathData' must hold values of the path's VG_PATH_DATATYPE (e.g.\n"
+"   array('f') for VG_PATH_DATATYPE_F), or be raw bytes already packed in\n"
+"   that datatype.\n"
+"\n"
+"   :arg numSegments: Number of path segments.\n"
+"   :type numSegments: int.\n"
+"   :arg pathSegments: Path segments.\n"
+"   :type pathSegments: list or buffer.\n"
+"   :arg pathData: Path coordinates.\n"
+"   :type pathData: list or buffer.\n"
+"\n"
+"   :error: VG_BAD_HANDLE_ERROR.\n"
+"   :error: VG_PATH_CAPABILITY_ERROR.\n"
+"   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
+);
+
+STATS_ENTRY(stats_vgAppendPathData, "VGPath.append_data");
+
+static PyObject *
+OpenVG_vgAppendPathData(PyVGPath *self, PyObject *args, PyObject *kwargs)
+{
+    VGint numSegments;
+    PyObject *py_segments;
+    PyObject *py_data;
+    Py_buffer segments;
+    Py_buffer data;
+    VGPathDatatype type;
+    Py_ssize_t count;
+    Py_ssize_t idx;
+    int coords = 0;
+
+    const char *keywords[] = {"numSegments", "pathSegments", "pathData", NULL};
+
+    stats_scope stats(&stats_vgAppendPathData);
+    stats.handle = self->obj;
+    
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iOO", (char **) keywords, &numSegments, &py_segments, &py_data)) {
+        return NULL;
+    }
+
+    if (path_segments_acquire(py_segments, &segments) < 0)
+        return NULL;
+
+    if (numSegments != segments.len) {
+        path_buffer_release(&segments);
+        PyErr_SetString(PyExc_TypeError,
+                        "Length of `pathSegments' and `numSegments' do not match");
+        return NULL;
+    }
+
+    for (idx = 0; idx < segments.len; idx++) {
+        int n = path_segment_coords(((VGubyte *)segments.buf)[idx]);
+
+        if (n < 0) {
+            path_buffer_release(&segments);
+            PyErr_SetString(PyExc_TypeError, "VG_ILLEGAL_ARGUMENT_ERROR");
+            return NULL;
+        }
+        coords += n;
+    }
+
+    backend_wait();
+    type = (VGPathDatatype)vgGetParameteri(self->obj, VG_PATH_DATATYPE);
+
+    if ((count = path_data_acquire(py_data, type, &data)) < 0) {
+        path_buffer_release(&segments);
+        return NULL;
+    }
+    stats.bytes = segments.len + count * path_datatype_size(type);
+
+    if (count != coords) {
+        path_buffer_release(&segments);
+        path_buffer_release(&data);
+        PyErr_SetString(PyExc_TypeError,
+                        "Length of `pathData' does not match `pathSegments'");
+        return NULL;
+    }
+
+    VG_BEGIN_ALLOW_THREADS
+    vgAppendPathData(self->obj, numSegments,
+                     (const VGubyte *)segments.buf, data.buf);
+    VG_END_ALLOW_THREADS
+
+    if (check_error()) {
+        path_buffer_release(&segments);
+        path_buffer_release(&data);
+        return NULL;
+    }
+
+    if (path_forget_unchecked(self)) {
+        path_buffer_release(&segments);
+        path_buffer_release(&data);
+        Py_RETURN_NONE;
+    }
+
+    path_record_segments(self, (const VGubyte *)segments.buf, numSegments);
+    path_buffer_release(&segments);
+
+    path_record_data(self, data.buf, (VGint)count, numSegments);
+    path_buffer_release(&data);
+
+    Py_RETURN_NONE;
+}
+
+
+/* Integer format characters accepted for offset arrays. */
+static bool
+path_offsets_format(const char *format, Py_ssize_t itemsize)
+{
+    if ((format = path_native_format(format)) == NULL)
+        return false;
+
+    if (format[0] == '\0' || format[1] != '\0')
+        return false;
+
+    if (itemsize != 4 && itemsize != 8)
+        return false;
+
+    return strchr("iIlLqQnN", *format) != NULL;
+}
+
+static int
+path_offsets_acquire(PyObject *obj, const char *name, Py_buffer *view)
+{
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+        return -1;
+
+    if (!path_offsets_format(view->format, view->itemsize) ||
+        view->len < 2 * view->itemsize) {
+        PyBuffer_Release(view);
+        PyErr_Format(PyExc_TypeError,
+                     "Parameter `%s' must be a buffer of at least 2 32 or 64 bit integers",
+                     name);
+        return -1;
+    }
+    return 0;
 }
 
-static PyObject *
-PyVGPath__exit__(PyVGPath *self, PyObject *args)
+static Py_ssize_t
+path_offset_at(Py_buffer *view, Py_ssize_t idx)
 {
-    PyObject *py_retval = PyObject_CallMethod((PyObject *)self, (char *)"draw", NULL);
+    if (view->itemsize == 4)
+        return ((const VGint *)view->buf)[idx];
+    return (Py_ssize_t)((const long long *)view->buf)[idx];
+}
 
-    if (!py_retval)
-        return NULL;
+/* Are the offsets in `view' ascending from 0 to at most `limit'? */
+static bool
+path_offsets_valid(Py_buffer *view, Py_ssize_t limit)
+{
+    Py_ssize_t idx, count = view->len / view->itemsize;
 
-    Py_DECREF(py_retval);
+    if (path_offset_at(view, 0) < 0)
+        return false;
 
-    Py_RETURN_NONE;
+    for (idx = 1; idx < count; idx++) {
+        if (path_offset_at(view, idx) < path_offset_at(view, idx - 1))
+            return false;
+    }
+    return path_offset_at(view, count - 1) <= limit;
 }
 
-
-PyDoc_STRVAR(OpenVG_vgAppendPath__doc__,
-".. function:: append(srcPath)\n"
+PyDoc_STRVAR(PyVGPath_from_arrays__doc__,
+".. function:: from_arrays(coords, offsets[, features, closed, merge, capabilities])\n"
 "\n"
-"   Append data from `srcPath'.\n"
+"   Build paths of lines from a flat coordinate buffer without creating\n"
+"   Python objects per vertex.  Ring `i' is made of the vertices\n"
+"   offsets[i] to offsets[i + 1], as in GeoArrow.\n"
 "\n"
-"   :arg srcPath: Source path.\n"
-"   :type srcPath: VGPath.\n"
+"   :arg coords: x, y pairs of all rings.\n"
+"   :type coords: buffer of float32 or float64.\n"
+"   :arg offsets: Vertex offset of each ring, and the end of the last.\n"
+"   :type offsets: buffer of 32 or 64 bit integers.\n"
+"   :arg features: Ring offset of each feature, and the end of the last,\n"
+"      one path is made per feature instead of per ring.\n"
+"   :type features: buffer of 32 or 64 bit integers.\n"
+"   :arg closed: Close every ring, default True.  A last vertex equal\n"
+"      to the first is dropped, the close segment draws that edge.\n"
+"   :type closed: bool.\n"
+"   :arg merge: Return a single path with every ring, default False.\n"
+"   :type merge: bool.\n"
+"   :arg capabilities: Capabilities of the new paths, default all.\n"
+"   :type capabilities: int.\n"
+"   :return: The paths, or the merged path.\n"
+"   :rtype: list of VGPath or VGPath.\n"
 "\n"
-"   :error: VG_BAD_HANDLE_ERROR.\n"
-"   :error: VG_PATH_CAPABILITY_ERROR.\n"
+"   :error: ValueError if `coords' holds an odd number of values.\n"
+"   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_from_arrays, "VGPath.from_arrays");
+
 static PyObject *
-OpenVG_vgAppendPath(PyVGPath *self, PyObject *args, PyObject *kwargs)
+PyVGPath_from_arrays(PyTypeObject *type, PyObject *args, PyObject *kwargs)
 {
-    PyVGPath *srcPath;
-    const char *keywords[] = {"srcPath", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!", (char **) keywords, &PyVGPath_Type, &srcPath)) {
+    PyObject *py_coords;
+    PyObject *py_offsets;
+    PyObject *py_features = Py_None;
+    PyObject *py_closed = Py_True;
+    PyObject *py_merge = Py_False;
+    unsigned int capabilities = VG_PATH_CAPABILITY_ALL;
+    Py_buffer coords, offsets, features;
+    VGfloat *points = NULL;
+    VGubyte *segments = NULL;
+    Py_ssize_t *ring_segments = NULL, *ring_points = NULL;
+    Py_ssize_t num_points, num_rings, num_paths, idx, ring;
+    PyObject *py_retval = NULL;
+    int closed, merge;
+    bool repeated = false;
+
+    const char *keywords[] = {"coords", "offsets", "features", "closed",
+                              "merge", "capabilities", NULL};
+
+    stats_scope stats(&stats_from_arrays);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "OO|OOOI", (char **) keywords,
+                                     &py_coords, &py_offsets, &py_features,
+                                     &py_closed, &py_merge, &capabilities)) {
         return NULL;
     }
 
-    vgAppendPath(self->obj, srcPath->obj);
+    if ((closed = PyObject_IsTrue(py_closed)) < 0)
+        return NULL;
+    if ((merge = PyObject_IsTrue(py_merge)) < 0)
+        return NULL;
 
-    if (check_error())
+    if (PyObject_GetBuffer(py_coords, &coords, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
         return NULL;
 
-    Py_RETURN_NONE;
+    if (coords.format == NULL || coords.format[0] == '\0' || coords.format[1] != '\0' ||
+        !((coords.format[0] == 'f' && coords.itemsize == 4) ||
+          (coords.format[0] == 'd' && coords.itemsize == 8))) {
+        PyBuffer_Release(&coords);
+        PyErr_SetString(PyExc_TypeError,
+                        "Parameter `coords' must be a buffer of float32 or float64");
+        return NULL;
+    }
+    if ((coords.len / coords.itemsize) % 2) {
+        PyBuffer_Release(&coords);
+        PyErr_SetString(PyExc_ValueError,
+                        "Parameter `coords' must be a multiple of 2");
+        return NULL;
+    }
+    num_points = coords.len / coords.itemsize / 2;
+    stats.bytes = coords.len;
+
+    if (path_offsets_acquire(py_offsets, "offsets", &offsets) < 0) {
+        PyBuffer_Release(&coords);
+        return NULL;
+    }
+    num_rings = offsets.len / offsets.itemsize - 1;
+    num_paths = num_rings;
+
+    if (!path_offsets_valid(&offsets, num_points)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Parameter `offsets' must ascend within `coords'");
+        goto release_offsets;
+    }
+
+    if (py_features != Py_None) {
+        if (path_offsets_acquire(py_features, "features", &features) < 0)
+            goto release_offsets;
+        num_paths = features.len / features.itemsize - 1;
+
+        if (!path_offsets_valid(&features, num_rings)) {
+            PyErr_SetString(PyExc_ValueError,
+                            "Parameter `features' must ascend within `offsets'");
+            goto release_features;
+        }
+    }
+    if (merge)
+        num_paths = 1;
+
+    /* float64 input is narrowed once, float32 is appended in place */
+    if (coords.itemsize == 4) {
+        points = (VGfloat *)coords.buf;
+    }
+    else {
+        points = PyMem_New(VGfloat, num_points ? num_points * 2 : 1);
+        if (points == NULL) {
+            PyErr_NoMemory();
+            goto release_features;
+        }
+        for (idx = 0; idx < num_points * 2; idx++) {
+            points[idx] = (VGfloat)((const double *)coords.buf)[idx];
+        }
+    }
+
+    /*
+     * A closed ring that repeats its first vertex at the end, as GeoJSON
+     * and WKB polygons do, would get a zero length line before the close:
+     * the repeat is dropped and the points compacted.
+     */
+    ring_points = PyMem_New(Py_ssize_t, num_rings + 1);
+    if (ring_points == NULL) {
+        PyErr_NoMemory();
+        goto release_points;
+    }
+    ring_points[0] = 0;
+    for (ring = 0; ring < num_rings; ring++) {
+        Py_ssize_t start = path_offset_at(&offsets, ring);
+        Py_ssize_t end = path_offset_at(&offsets, ring + 1);
+
+        if (closed && end - start > 1 &&
+            points[2 * start] == points[2 * end - 2] &&
+            points[2 * start + 1] == points[2 * end - 1]) {
+            end--;
+            repeated = true;
+        }
+        ring_points[ring + 1] = ring_points[ring] + end - start;
+    }
+
+    if (repeated) {
+        const VGfloat *src = points;
+
+        if (points == coords.buf) {
+            points = PyMem_New(VGfloat, ring_points[num_rings] ? ring_points[num_rings] * 2 : 1);
+            if (points == NULL) {
+                points = (VGfloat *)coords.buf;
+                PyErr_NoMemory();
+                goto release_points;
+            }
+        }
+        for (ring = 0; ring < num_rings; ring++) {
+            memmove(points + 2 * ring_points[ring],
+                    src + 2 * path_offset_at(&offsets, ring),
+                    (ring_points[ring + 1] - ring_points[ring]) * 2 * sizeof(VGfloat));
+        }
+    }
+
+    /* the segments of every ring, back to back like the coordinates */
+    ring_segments = PyMem_New(Py_ssize_t, num_rings + 1);
+    segments = PyMem_New(VGubyte, num_points + (closed ? num_rings : 0) + 1);
+    if (ring_segments == NULL || segments == NULL) {
+        PyErr_NoMemory();
+        goto release_points;
+    }
+    ring_segments[0] = 0;
+    for (ring = 0; ring < num_rings; ring++) {
+        Py_ssize_t start = ring_points[ring];
+        Py_ssize_t end = ring_points[ring + 1];
+        VGubyte *segment = segments + ring_segments[ring];
+
+        for (idx = start; idx < end; idx++) {
+            *segment++ = idx == start ? VG_MOVE_TO_ABS : VG_LINE_TO_ABS;
+        }
+        if (closed && end > start)
+            *segment++ = VG_CLOSE_PATH;
+        ring_segments[ring + 1] = segment - segments;
+    }
+
+    py_retval = PyList_New(num_paths);
+    if (py_retval == NULL)
+        goto release_points;
+
+    for (idx = 0; idx < num_paths; idx++) {
+        Py_ssize_t first = idx, last = idx + 1;
+        Py_ssize_t num_segments, num_coords;
+        const VGfloat *data;
+        PyVGPath *path;
+
+        if (merge) {
+            first = 0;
+            last = num_rings;
+        }
+        else if (py_features != Py_None) {
+            first = path_offset_at(&features, idx);
+            last = path_offset_at(&features, idx + 1);
+        }
+
+        num_segments = ring_segments[last] - ring_segments[first];
+        num_coords = 2 * (ring_points[last] - ring_points[first]);
+        data = points + 2 * ring_points[first];
+
+        path = (PyVGPath *)type->tp_alloc(type, 0);
+        if (path == NULL) {
+            Py_CLEAR(py_retval);
+            goto release_points;
+        }
+        PyList_SET_ITEM(py_retval, idx, (PyObject *)path);
+
+        if (path_init(path, VG_PATH_FORMAT_STANDARD, VG_PATH_DATATYPE_F, 1.0f, 0.0f,
+                      (VGint)num_segments, (VGint)num_coords, capabilities) < 0) {
+            Py_CLEAR(py_retval);
+            goto release_points;
+        }
+
+        if (num_segments == 0)
+            continue;
+
+        VG_BEGIN_ALLOW_THREADS
+        vgAppendPathData(path->obj, (VGint)num_segments,
+                         segments + ring_segments[first], data);
+        VG_END_ALLOW_THREADS
+
+        if (check_error()) {
+            Py_CLEAR(py_retval);
+            goto release_points;
+        }
+
+        if (path_forget_unchecked(path))
+            continue;
+
+        path_record_segments(path, segments + ring_segments[first], (VGint)num_segments);
+        path_record_data(path, data, (VGint)num_coords, (VGint)num_segments);
+    }
+
+    if (merge) {
+        PyObject *merged = PyList_GET_ITEM(py_retval, 0);
+
+        Py_INCREF(merged);
+        Py_DECREF(py_retval);
+        py_retval = merged;
+    }
+
+release_points:
+    PyMem_Free(segments);
+    PyMem_Free(ring_segments);
+    PyMem_Free(ring_points);
+    if (points != coords.buf)
+        PyMem_Free(points);
+release_features:
+    if (py_features != Py_None)
+        PyBuffer_Release(&features);
+release_offsets:
+    PyBuffer_Release(&offsets);
+    PyBuffer_Release(&coords);
+    return py_retval;
 }
 
 
-PyDoc_STRVAR(OpenVG_vgAppendPathData__doc__,
-".. function:: append_data(numSegments, pathSegments, pathData)\n"
+PyDoc_STRVAR(PyVGPath_append_svg__doc__,
+".. function:: append_svg(d)\n"
 "\n"
-"   Append data from `pathData'.\n"
+"   Append SVG path data, the `d' attribute of an SVG path element, with a\n"
+"   single vgAppendPathData.  Coordinates are converted to the path's\n"
+"   datatype, scale and bias.\n"
 "\n"
-"   :arg numSegments: Number of path segments.\n"
-"   :type numSegments: int.\n"
-"   :arg pathSegments: Path segments.\n"
-"   :type pathSegments: list.\n"
-"   :arg pathData: Path segments.\n"
-"   :type pathData: list.\n"
+"   :arg d: SVG path data.\n"
+"   :type d: str.\n"
 "\n"
+"   :error: ValueError if `d' is malformed, doesn't start with a moveto or\n"
+"      is out of the datatype's range.\n"
 "   :error: VG_BAD_HANDLE_ERROR.\n"
 "   :error: VG_PATH_CAPABILITY_ERROR.\n"
-"   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_append_svg, "VGPath.append_svg");
+
 static PyObject *
-OpenVG_vgAppendPathData(PyVGPath *self, PyObject *args, PyObject *kwargs)
+PyVGPath_append_svg(PyVGPath *self, PyObject *args, PyObject *kwargs)
 {
-    VGint numSegments;
-    VGubyte *pathSegments;
-    PyObject *py_segments;
-    VGPathDatatype type;
-    void *pathData = NULL;
-    PyObject *py_data;
-    int count, idx;
+    const char *d;
+    Py_ssize_t length, error;
+    VGubyte *segments;
+    VGfloat *coords;
+    void *data;
+    VGint numSegments, numCoords;
+    int size = path_datatype_size(self->datatype);
 
-    const char *keywords[] = {"numSegments", "pathSegments", "pathData", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iO!O!", (char **) keywords, &numSegments, &PyList_Type, &py_segments, &PyList_Type, &py_data)) {
+    const char *keywords[] = {"d", NULL};
+
+    stats_scope stats(&stats_append_svg);
+    stats.handle = self->obj;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "s", (char **) keywords, &d)) {
         return NULL;
     }
 
-    if (numSegments != PyList_Size(py_segments)) {
-        PyErr_SetString(PyExc_TypeError,
-                        "Length of `pathSegments' and `numSegments' do not match");
+    if (size == 0) {
+        PyErr_SetString(PyExc_ValueError, "VG_UNSUPPORTED_PATH_FORMAT_ERROR");
         return NULL;
     }
 
-    pathSegments = (VGubyte*)malloc(sizeof(VGubyte) * numSegments);
-    for (idx = 0; idx < numSegments; idx++) {
-        PyObject *element = PyList_GET_ITEM(py_segments, idx);
-        pathSegments[idx] = (VGubyte) PyLong_AsUnsignedLong(element);
+    /* one block holds both: an entry takes at least one char of `d' */
+    length = strlen(d);
+    stats.bytes = length;
+    coords = (VGfloat *)PyMem_Malloc((length + 1) * (sizeof(VGfloat) + 1));
+    if (coords == NULL)
+        return PyErr_NoMemory();
+    segments = (VGubyte *)(coords + length + 1);
+
+    error = path_parse_svg(d, length, segments, coords, &numSegments, &numCoords);
+    if (error >= 0) {
+        PyMem_Free(coords);
+        if (!PyErr_Occurred())
+            PyErr_Format(PyExc_ValueError, "invalid SVG path data at offset %zd", error);
+        return NULL;
     }
 
-    count = PyList_Size(py_data);
-    type = (VGPathDatatype)vgGetParameteri(self->obj, VG_PATH_DATATYPE);
-    switch (type) {
-        case VG_PATH_DATATYPE_S_8:
-            pathData = malloc(sizeof(VGbyte) * count);
-            break;
-        case VG_PATH_DATATYPE_S_16:
-            pathData = malloc(sizeof(VGshort) * count);
-            break;
-        case VG_PATH_DATATYPE_S_32:
-            pathData = malloc(sizeof(VGint) * count);
-            break;
-        case VG_PATH_DATATYPE_F:
-            pathData = malloc(sizeof(VGfloat) * count);
-            break;
+    if (numSegments == 0) {
+        PyMem_Free(coords);
+        Py_RETURN_NONE;
     }
-    for (idx = 0; idx < count; idx++) {
-        PyObject *element = PyList_GET_ITEM(py_data, idx);
-        switch (type) {
-            case VG_PATH_DATATYPE_S_8: {
-                VGbyte *tmp = (VGbyte*)pathData;
-                tmp[idx] = (VGbyte) PyLong_AsLong(element);
-                break;
-            }
-            case VG_PATH_DATATYPE_S_16: {
-                VGshort *tmp = (VGshort*)pathData;
-                tmp[idx] = (VGshort) PyLong_AsLong(element);
-                break;
-            }
-            case VG_PATH_DATATYPE_S_32: {
-                VGint *tmp = (VGint*)pathData;
-                tmp[idx] = (VGint) PyLong_AsLong(element);
-                break;
-            }
-            case VG_PATH_DATATYPE_F: {
-                VGfloat *tmp = (VGfloat*)pathData;
-                tmp[idx] = (VGfloat) PyFloat_AsDouble(element);
-                break;
-            }
+
+    data = coords;
+    if (self->datatype != VG_PATH_DATATYPE_F || self->scale != 1.0f || self->bias != 0.0f) {
+        data = PyMem_Malloc(numCoords ? size * numCoords : 1);
+        if (data == NULL) {
+            PyMem_Free(coords);
+            return PyErr_NoMemory();
+        }
+        if (!path_user_to_data(coords, self->datatype, self->scale, self->bias,
+                               data, numCoords)) {
+            PyMem_Free(data);
+            PyMem_Free(coords);
+            PyErr_SetString(PyExc_ValueError,
+                            "SVG path data is out of range of the path's VG_PATH_DATATYPE");
+            return NULL;
         }
     }
 
-    vgAppendPathData(self->obj, numSegments, pathSegments, pathData);
+    VG_BEGIN_ALLOW_THREADS
+    vgAppendPathData(self->obj, numSegments, segments, data);
+    VG_END_ALLOW_THREADS
 
-    free(pathSegments);
-    free(pathData);
-
-    if (check_error())
+    if (check_error()) {
+        if (data != coords)
+            PyMem_Free(data);
+        PyMem_Free(coords);
         return NULL;
+    }
+
+    if (!path_forget_unchecked(self)) {
+        path_record_segments(self, segments, numSegments);
+        path_record_data(self, data, numCoords, numSegments);
+    }
+
+    if (data != coords)
+        PyMem_Free(data);
+    PyMem_Free(coords);
 
     Py_RETURN_NONE;
 }
@@ -275,19 +1358,15 @@ PyDoc_STRVAR(OpenVG_vgPathBounds__doc__,
 static PyObject *
 OpenVG_vgPathBounds(PyVGPath *self, PyObject *args, PyObject *kwargs)
 {
-    PyObject *py_retval;
-    VGfloat  minX;
-    VGfloat  minY;
-    VGfloat  width;
-    VGfloat  height;
+    VGfloat bounds[4];      /* minX, minY, width, height */
 
-    vgPathBounds(self->obj, &minX, &minY, &width, &height);
+    backend_wait();
+    vgPathBounds(self->obj, &bounds[0], &bounds[1], &bounds[2], &bounds[3]);
 
     if (check_error())
         return NULL;
 
-    py_retval = Py_BuildValue((char *) "ffff", minX, minY, width, height);
-    return py_retval;
+    return fast_float_tuple(bounds, 4);
 }
 
 
@@ -308,12 +1387,13 @@ OpenVG_vgGetPathCapabilities(PyVGPath *self, PyObject *args, PyObject *kwargs)
     PyObject *py_retval;
     VGbitfield retval;
 
+    backend_wait();
     retval = vgGetPathCapabilities(self->obj);
 
     if (check_error())
         return NULL;
 
-    py_retval = Py_BuildValue((char *) "N", PyLong_FromUnsignedLong(retval));
+    py_retval = PyLong_FromUnsignedLong(retval);
     return py_retval;
 }
 
@@ -329,22 +1409,29 @@ PyDoc_STRVAR(OpenVG_vgRemovePathCapabilities__doc__,
 "   :error: VG_BAD_HANDLE_ERROR.\n"
 );
 
+static const char *const OpenVG_vgRemovePathCapabilities_keywords[] = {"capabilities", NULL};
+static const struct fast_parser OpenVG_vgRemovePathCapabilities_parser = {"capabilities_remove", OpenVG_vgRemovePathCapabilities_keywords, 1, 1};
+
 static PyObject *
-OpenVG_vgRemovePathCapabilities(PyVGPath *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgRemovePathCapabilities(PyVGPath *self, FAST_ARGS)
 {
+    PyObject *argv[1];
     unsigned int capabilities;
-    const char *keywords[] = {"capabilities", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "I", (char **) keywords, &capabilities)) {
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgRemovePathCapabilities_parser, argv) ||
+        !fast_bitfield(argv[0], &capabilities)) {
         return NULL;
     }
 
+    backend_wait();
     vgRemovePathCapabilities(self->obj, capabilities);
     self->capabilities = vgGetPathCapabilities(self->obj);
 
     if (check_error())
         return NULL;
 
+    path_release_coords(self);
+
     Py_RETURN_NONE;
 }
 
@@ -360,7 +1447,9 @@ PyDoc_STRVAR(OpenVG_vgClearPath__doc__,
 static PyObject *
 OpenVG_vgClearPath(PyVGPath *self)
 {
+    backend_wait();
     vgClearPath(self->obj, self->capabilities);
+    path_clear_segments(self);
 
     Py_RETURN_NONE;
 }
@@ -375,15 +1464,79 @@ PyDoc_STRVAR(OpenVG_vgDrawPath__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgDrawPath, "VGPath.draw");
+
 static PyObject *
 OpenVG_vgDrawPath(PyVGPath *self)
 {
-    vgDrawPath(self->obj, self->paint_modes);
+    VGPath handle;
+
+    stats_scope stats(&stats_vgDrawPath);
+    stats.handle = self->obj;
+
+    handle = path_tessellation(self);
+
+    VG_BEGIN_ALLOW_THREADS
+    vgDrawPath(handle, self->paint_modes);
+    VG_END_ALLOW_THREADS
 
     Py_RETURN_NONE;
 }
 
 
+PyDoc_STRVAR(PyVGPath_get_data__doc__,
+".. function:: get_data()\n"
+"\n"
+"   Export the segments and coordinates of the path, in the form\n"
+"   append_data() takes them.  OpenVG can't read path data back, so this\n"
+"   is the data appended through these bindings, byte for byte; paths\n"
+"   changed by transform(), interpolate() or the VGU functions, or added\n"
+"   to while errors are deferred, can't be exported.\n"
+"\n"
+"   :return: The segment commands and the coordinates packed in the path's\n"
+"      VG_PATH_DATATYPE.\n"
+"   :rtype: tuple of bytes, bytes.\n"
+"\n"
+"   :error: VG_PATH_CAPABILITY_ERROR without VG_PATH_CAPABILITY_APPEND_FROM.\n"
+"   :error: RuntimeError if the data of the path is not known.\n"
+);
+
+static PyObject *
+PyVGPath_get_data(PyVGPath *self)
+{
+    PyObject *py_segments, *py_data;
+    int size = path_datatype_size(self->datatype);
+
+    /* reading the data is what vgAppendPath() needs of its source */
+    if (!(self->capabilities & VG_PATH_CAPABILITY_APPEND_FROM)) {
+        PyErr_SetString(PyExc_ValueError, "VG_PATH_CAPABILITY_ERROR");
+        return NULL;
+    }
+
+    if (size == 0 || !path_coords_known(self)) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "the data of the path was not appended through VGPath");
+        return NULL;
+    }
+
+    py_segments = PyBytes_FromStringAndSize((const char *)self->segments,
+                                            self->num_segments);
+    if (py_segments == NULL)
+        return NULL;
+
+    py_data = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)size * self->num_coords);
+    if (py_data == NULL) {
+        Py_DECREF(py_segments);
+        return NULL;
+    }
+
+    /* the bytes handed to the backend, as they were */
+    memcpy(PyBytes_AS_STRING(py_data), self->data, (size_t)size * self->num_coords);
+
+    return Py_BuildValue((char *) "NN", py_segments, py_data);
+}
+
+
 PyDoc_STRVAR(OpenVG_vgInterpolatePath__doc__,
 ".. function:: interpolate(startPath, endPath, amount)\n"
 "\n"
@@ -403,26 +1556,69 @@ PyDoc_STRVAR(OpenVG_vgInterpolatePath__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgInterpolatePath, "VGPath.interpolate");
+
+static const char *const OpenVG_vgInterpolatePath_keywords[] = {"startPath", "endPath", "amount", NULL};
+static const struct fast_parser OpenVG_vgInterpolatePath_parser = {"interpolate", OpenVG_vgInterpolatePath_keywords, 3, 3};
+
 static PyObject *
-OpenVG_vgInterpolatePath(PyVGPath *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgInterpolatePath(PyVGPath *self, FAST_ARGS)
 {
+    PyObject *argv[3];
     PyObject *py_retval;
     bool retval;
     PyVGPath *startPath;
     PyVGPath *endPath;
     VGfloat amount;
-    const char *keywords[] = {"startPath", "endPath", "amount", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!O!f", (char **) keywords, &PyVGPath_Type, &startPath, &PyVGPath_Type, &endPath, &amount)) {
+
+    stats_scope stats(&stats_vgInterpolatePath);
+    stats.handle = self->obj;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgInterpolatePath_parser, argv) ||
+        !fast_object(argv[0], &PyVGPath_Type, &startPath) ||
+        !fast_object(argv[1], &PyVGPath_Type, &endPath) ||
+        !fast_float(argv[2], &amount)) {
         return NULL;
     }
 
+    VG_BEGIN_ALLOW_THREADS
     retval = vgInterpolatePath(self->obj, startPath->obj, endPath->obj, amount);
+    VG_END_ALLOW_THREADS
 
     if (check_error())
         return NULL;
 
-    py_retval = Py_BuildValue((char *) "N", PyBool_FromLong(retval));
+    if (path_forget_unchecked(self))
+        return PyBool_FromLong(retval);
+
+    if (retval) {
+        /* the result is appended in the normalized form of `startPath',
+           which may be self: take the count first */
+        VGint idx, num_segments = startPath->num_segments;
+
+        if (num_segments < 0)
+            path_forget_segments(self);
+
+        for (idx = 0; idx < num_segments; idx++) {
+            VGubyte segment = startPath->segments[idx] & ~VG_RELATIVE;
+
+            switch (segment) {
+                case VG_HLINE_TO:
+                case VG_VLINE_TO:
+                    segment = VG_LINE_TO;
+                    break;
+                case VG_QUAD_TO:
+                case VG_SQUAD_TO:
+                case VG_SCUBIC_TO:
+                    segment = VG_CUBIC_TO;
+                    break;
+            }
+            path_record_segments(self, &segment, 1);
+        }
+        path_verify_segments(self);
+    }
+
+    py_retval = PyBool_FromLong(retval);
     return py_retval;
 }
 
@@ -444,19 +1640,25 @@ PyDoc_STRVAR(OpenVG_vgPathLength__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+static const char *const OpenVG_vgPathLength_keywords[] = {"startSegment", "numSegments", NULL};
+static const struct fast_parser OpenVG_vgPathLength_parser = {"length", OpenVG_vgPathLength_keywords, 2, 2};
+
 static PyObject *
-OpenVG_vgPathLength(PyVGPath *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgPathLength(PyVGPath *self, FAST_ARGS)
 {
+    PyObject *argv[2];
     PyObject *py_retval;
     VGfloat retval;
     VGint startSegment;
     VGint numSegments;
-    const char *keywords[] = {"startSegment", "numSegments", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "ii", (char **) keywords, &startSegment, &numSegments)) {
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgPathLength_parser, argv) ||
+        !fast_int(argv[0], &startSegment) ||
+        !fast_int(argv[1], &numSegments)) {
         return NULL;
     }
 
+    backend_wait();
     retval = vgPathLength(self->obj, startSegment, numSegments);
 
     if (check_error())
@@ -468,86 +1670,99 @@ OpenVG_vgPathLength(PyVGPath *self, PyObject *args, PyObject *kwargs)
 
 
 PyDoc_STRVAR(OpenVG_vgModifyPathCoords__doc__,
-".. function:: modify_coords(startPath, endPath, pathData)\n"
+".. function:: modify_coords(startIndex, numSegments, pathData)\n"
 "\n"
 "   Modify coordinates stored in a path.\n"
 "\n"
-"   :arg startSegment: Index of the start segment.\n"
-"   :type startSegment: int.\n"
+"   `pathData' is handed to OpenVG without copying when it is a buffer\n"
+"   of the path's VG_PATH_DATATYPE; its length must match the number of\n"
+"   coordinates taken by the modified segments.\n"
+"\n"
+"   :arg startIndex: Index of the start segment.\n"
+"   :type startIndex: int.\n"
 "   :arg numSegments: Number of segments.\n"
 "   :type numSegments: int.\n"
-"   :arg pathData: List of modified path segments.\n"
-"   :type: list.\n"
+"   :arg pathData: Modified path coordinates.\n"
+"   :type: list or buffer.\n"
 "\n"
 "   :error: VG_BAD_HANDLE_ERROR.\n"
 "   :error: VG_PATH_CAPABILITY_ERROR.\n"
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgModifyPathCoords, "VGPath.modify_coords");
+
 static PyObject *
 OpenVG_vgModifyPathCoords(PyVGPath *self, PyObject *args, PyObject *kwargs)
 {
     VGint startIndex;
     VGint numSegments;
-    VGPathDatatype type;
-    void *pathData = NULL;
     PyObject *py_data;
-    int count, idx;
+    Py_buffer data;
+    Py_ssize_t count;
+    int coords = 0;
+    int idx, size;
 
     const char *keywords[] = {"startIndex", "numSegments", "pathData", NULL};
+
+    stats_scope stats(&stats_vgModifyPathCoords);
+    stats.handle = self->obj;
     
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiO!", (char **) keywords, &startIndex, &numSegments, &PyList_Type, &py_data)) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iiO", (char **) keywords, &startIndex, &numSegments, &py_data)) {
         return NULL;
     }
 
-    count = PyList_Size(py_data);
-    type = (VGPathDatatype)vgGetParameteri(self->obj, VG_PATH_DATATYPE);
-    switch (type) {
-        case VG_PATH_DATATYPE_S_8:
-            pathData = malloc(sizeof(VGbyte) * count);
-            break;
-        case VG_PATH_DATATYPE_S_16:
-            pathData = malloc(sizeof(VGshort) * count);
-            break;
-        case VG_PATH_DATATYPE_S_32:
-            pathData = malloc(sizeof(VGint) * count);
-            break;
-        case VG_PATH_DATATYPE_F:
-            pathData = malloc(sizeof(VGfloat) * count);
-            break;
+    if (self->num_segments < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "VGPath.modify_coords(): segment layout of the path is unknown");
+        return NULL;
     }
-    for (idx = 0; idx < count; idx++) {
-        PyObject *element = PyList_GET_ITEM(py_data, idx);
-        switch (type) {
-            case VG_PATH_DATATYPE_S_8: {
-                VGbyte *tmp = (VGbyte*)pathData;
-                tmp[idx] = (VGbyte) PyLong_AsLong(element);
-                break;
-            }
-            case VG_PATH_DATATYPE_S_16: {
-                VGshort *tmp = (VGshort*)pathData;
-                tmp[idx] = (VGshort) PyLong_AsLong(element);
-                break;
-            }
-            case VG_PATH_DATATYPE_S_32: {
-                VGint *tmp = (VGint*)pathData;
-                tmp[idx] = (VGint) PyLong_AsLong(element);
-                break;
-            }
-            case VG_PATH_DATATYPE_F: {
-                VGfloat *tmp = (VGfloat*)pathData;
-                tmp[idx] = (VGfloat) PyFloat_AsDouble(element);
-                break;
-            }
-        }
+
+    if (startIndex < 0 || numSegments <= 0 ||
+        numSegments > self->num_segments - startIndex) {
+        PyErr_SetString(PyExc_TypeError, "VG_ILLEGAL_ARGUMENT_ERROR");
+        return NULL;
     }
 
-    vgModifyPathCoords(self->obj, startIndex, numSegments, pathData);
+    for (idx = startIndex; idx < startIndex + numSegments; idx++) {
+        coords += path_segment_coords(self->segments[idx]);
+    }
 
-    free(pathData);
+    backend_wait();
+    count = path_data_acquire(py_data,
+                              (VGPathDatatype)vgGetParameteri(self->obj, VG_PATH_DATATYPE),
+                              &data);
+    if (count < 0)
+        return NULL;
 
-    if (check_error())
+    if (count != coords) {
+        path_buffer_release(&data);
+        PyErr_SetString(PyExc_TypeError,
+                        "Length of `pathData' does not match `numSegments'");
+        return NULL;
+    }
+
+    VG_BEGIN_ALLOW_THREADS
+    vgModifyPathCoords(self->obj, startIndex, numSegments, data.buf);
+    VG_END_ALLOW_THREADS
+
+    if (check_error()) {
+        path_buffer_release(&data);
         return NULL;
+    }
+
+    path_invalidate_tessellation(self);
+
+    if (!path_forget_unchecked(self) && path_coords_known(self)) {
+        VGint first = 0;
+
+        for (idx = 0; idx < startIndex; idx++) {
+            first += path_segment_coords(self->segments[idx]);
+        }
+        size = path_datatype_size(self->datatype);
+        memcpy((char *)self->data + (size_t)first * size, data.buf, (size_t)count * size);
+    }
+    path_buffer_release(&data);
 
     Py_RETURN_NONE;
 }
@@ -572,30 +1787,33 @@ PyDoc_STRVAR(OpenVG_vgPointAlongPath__doc__,
 "   :error: VG_ILLEGAL_ARGUMENT_ERROR.\n"
 );
 
+static const char *const OpenVG_vgPointAlongPath_keywords[] = {"startSegment", "numSegments", "distance", NULL};
+static const struct fast_parser OpenVG_vgPointAlongPath_parser = {"point_along_path", OpenVG_vgPointAlongPath_keywords, 3, 3};
+
 static PyObject *
-OpenVG_vgPointAlongPath(PyVGPath *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgPointAlongPath(PyVGPath *self, FAST_ARGS)
 {
-    PyObject *py_retval;
+    PyObject *argv[3];
     VGint startSegment;
     VGint numSegments;
     VGfloat distance;
-    VGfloat  x;
-    VGfloat  y;
-    VGfloat  tangentX;
-    VGfloat  tangentY;
-    const char *keywords[] = {"startSegment", "numSegments", "distance", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "iif", (char **) keywords, &startSegment, &numSegments, &distance)) {
+    VGfloat point[4];       /* x, y, tangentX, tangentY */
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgPointAlongPath_parser, argv) ||
+        !fast_int(argv[0], &startSegment) ||
+        !fast_int(argv[1], &numSegments) ||
+        !fast_float(argv[2], &distance)) {
         return NULL;
     }
 
-    vgPointAlongPath(self->obj, startSegment, numSegments, distance, &x, &y, &tangentX, &tangentY);
+    backend_wait();
+    vgPointAlongPath(self->obj, startSegment, numSegments, distance,
+                     &point[0], &point[1], &point[2], &point[3]);
 
     if (check_error())
         return NULL;
 
-    py_retval = Py_BuildValue((char *) "ffff", x, y, tangentX, tangentY);
-    return py_retval;
+    return fast_float_tuple(point, 4);
 }
 
 
@@ -611,21 +1829,54 @@ PyDoc_STRVAR(OpenVG_vgTransformPath__doc__,
 "   :error: VG_PATH_CAPABILITY_ERROR.\n"
 );
 
+STATS_ENTRY(stats_vgTransformPath, "VGPath.transform");
+
+static const char *const OpenVG_vgTransformPath_keywords[] = {"srcPath", NULL};
+static const struct fast_parser OpenVG_vgTransformPath_parser = {"transform", OpenVG_vgTransformPath_keywords, 1, 1};
+
 static PyObject *
-OpenVG_vgTransformPath(PyVGPath *self, PyObject *args, PyObject *kwargs)
+OpenVG_vgTransformPath(PyVGPath *self, FAST_ARGS)
 {
+    PyObject *argv[1];
     PyVGPath *srcPath;
-    const char *keywords[] = {"srcPath", NULL};
-    
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!", (char **) keywords, &PyVGPath_Type, &srcPath)) {
+
+    stats_scope stats(&stats_vgTransformPath);
+    stats.handle = self->obj;
+
+    if (!fast_unpack(FAST_PASS, &OpenVG_vgTransformPath_parser, argv) ||
+        !fast_object(argv[0], &PyVGPath_Type, &srcPath)) {
         return NULL;
     }
 
+    VG_BEGIN_ALLOW_THREADS
     vgTransformPath(self->obj, srcPath->obj);
+    VG_END_ALLOW_THREADS
 
     if (check_error())
         return NULL;
 
+    if (path_forget_unchecked(self) || srcPath->num_segments < 0) {
+        path_forget_segments(self);
+    }
+    else {
+        /* horizontal and vertical lines come back as general lines; the
+           count is taken first as srcPath may be self */
+        VGint idx, num_segments = srcPath->num_segments;
+
+        for (idx = 0; idx < num_segments; idx++) {
+            VGubyte segment = srcPath->segments[idx];
+
+            switch (segment & ~VG_RELATIVE) {
+                case VG_HLINE_TO:
+                case VG_VLINE_TO:
+                    segment = VG_LINE_TO | (segment & VG_RELATIVE);
+                    break;
+            }
+            path_record_segments(self, &segment, 1);
+        }
+        path_verify_segments(self);
+    }
+
     Py_RETURN_NONE;
 }
 
@@ -646,26 +1897,22 @@ PyDoc_STRVAR(OpenVG_vgPathTransformedBounds__doc__,
 static PyObject *
 OpenVG_vgPathTransformedBounds(PyVGPath *self, PyObject *args, PyObject *kwargs)
 {
-    PyObject *py_retval;
-    VGfloat  minX;
-    VGfloat  minY;
-    VGfloat  width;
-    VGfloat  height;
+    VGfloat bounds[4];      /* minX, minY, width, height */
 
-    vgPathTransformedBounds(self->obj, &minX, &minY, &width, &height);
+    backend_wait();
+    vgPathTransformedBounds(self->obj, &bounds[0], &bounds[1], &bounds[2], &bounds[3]);
 
     if (check_error())
         return NULL;
 
-    py_retval = Py_BuildValue((char *) "ffff", minX, minY, width, height);
-    return py_retval;
+    return fast_float_tuple(bounds, 4);
 }
 
 
 static PyMethodDef PyVGPath_methods[] = {
     {(char *) "append",
      (PyCFunction) OpenVG_vgAppendPath,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgAppendPath__doc__
     },
     {(char *) "append_data",
@@ -673,6 +1920,11 @@ static PyMethodDef PyVGPath_methods[] = {
      METH_KEYWORDS|METH_VARARGS,
      OpenVG_vgAppendPathData__doc__
     },
+    {(char *) "append_svg",
+     (PyCFunction) PyVGPath_append_svg,
+     METH_KEYWORDS|METH_VARARGS,
+     PyVGPath_append_svg__doc__
+    },
     {(char *) "bounds",
      (PyCFunction) OpenVG_vgPathBounds,
      METH_NOARGS,
@@ -685,7 +1937,7 @@ static PyMethodDef PyVGPath_methods[] = {
     },
     {(char *) "capabilities_remove",
      (PyCFunction) OpenVG_vgRemovePathCapabilities,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgRemovePathCapabilities__doc__
     },
     {(char *) "clear",
@@ -698,14 +1950,24 @@ static PyMethodDef PyVGPath_methods[] = {
      METH_NOARGS,
      OpenVG_vgDrawPath__doc__
     },
+    {(char *) "from_arrays",
+     (PyCFunction) PyVGPath_from_arrays,
+     METH_KEYWORDS|METH_VARARGS|METH_CLASS,
+     PyVGPath_from_arrays__doc__
+    },
+    {(char *) "get_data",
+     (PyCFunction) PyVGPath_get_data,
+     METH_NOARGS,
+     PyVGPath_get_data__doc__
+    },
     {(char *) "interpolate",
      (PyCFunction) OpenVG_vgInterpolatePath,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgInterpolatePath__doc__
     },
     {(char *) "length",
      (PyCFunction) OpenVG_vgPathLength,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgPathLength__doc__
     },
     {(char *) "modify_coords",
@@ -715,12 +1977,12 @@ static PyMethodDef PyVGPath_methods[] = {
     },
     {(char *) "point_along_path",
      (PyCFunction) OpenVG_vgPointAlongPath,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgPointAlongPath__doc__
     },
     {(char *) "transform",
      (PyCFunction) OpenVG_vgTransformPath,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      OpenVG_vgTransformPath__doc__
      },
     {(char *) "transformed_bounds",
@@ -747,6 +2009,7 @@ PyVGPath__mp_subscript(PyVGPath *self, PyObject *value)
     PyObject *py_retval;
     VGuint key = PyLong_AsUnsignedLong(value);
 
+    backend_wait();
     switch (key) {
         case VG_PATH_FORMAT:
         case VG_PATH_DATATYPE:
@@ -763,7 +2026,7 @@ PyVGPath__mp_subscript(PyVGPath *self, PyObject *value)
                             "VGPath[key]: key must be a VGPathParamType");
             return NULL;
     }
-    return Py_BuildValue((char *) "N", py_retval);
+    return py_retval;
 }
 
 static int
@@ -771,6 +2034,7 @@ PyVGPath__mp_ass_subscript(PyVGPath *self, PyObject *pykey, PyObject *value)
 {
     VGuint key = PyLong_AsUnsignedLong(pykey);
     
+    backend_wait();
     switch (key) {
         case VG_PATH_FORMAT:
         case VG_PATH_DATATYPE:
@@ -802,8 +2066,12 @@ PyVGPath__tp_dealloc(PyVGPath *self)
     if (self->obj) {
         VGPath tmp = self->obj;
         self->obj = NULL;
+        backend_wait();
         vgDestroyPath(tmp);
     }
+    path_invalidate_tessellation(self);
+    PyMem_Free(self->segments);
+    PyMem_Free(self->data);
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2012 Dan Eicher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file COPYING;
+ * if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * Binary path files of VG.save_paths() and VG.load_paths().  A header is
+ * followed by one record per path, then the segment and coordinate arrays
+ * of every path, each aligned to 8 bytes and in the path's own datatype,
+ * so loading hands the mapped file to vgAppendPathData as it is.  Files
+ * are in the byte order of the machine that wrote them.
+ */
+
+#include "openvg_module.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define PATH_FILE_MAGIC "OVGP"
+#define PATH_FILE_VERSION 1
+#define PATH_FILE_BYTE_ORDER 0x01020304
+#define PATH_FILE_ALIGN(offset) (((offset) + 7) & ~(uint64_t)7)
+
+struct path_file_header {
+    char magic[4];
+    VGuint version;
+    VGuint byte_order;
+    VGuint num_paths;
+};
+
+struct path_file_record {
+    VGuint datatype;
+    VGfloat scale, bias;
+    VGuint capabilities;
+    VGuint paint_modes;
+    VGfloat tessellation_tolerance;
+    VGfloat tessellation_band;
+    VGuint num_segments;
+    VGuint num_coords;
+    VGuint reserved;
+    uint64_t segments_offset;
+    uint64_t data_offset;
+};
+
+static bool
+path_file_write(FILE *file, const void *data, size_t size, uint64_t *offset)
+{
+    static const char padding[8] = {0};
+    size_t pad = PATH_FILE_ALIGN(*offset + size) - (*offset + size);
+
+    if (size && fwrite(data, 1, size, file) != size)
+        return false;
+    if (pad && fwrite(padding, 1, pad, file) != pad)
+        return false;
+
+    *offset += size + pad;
+    return true;
+}
+
+const char OpenVG_SavePaths__doc__[] = PyDoc_STR(
+".. function:: save_paths(filename, paths)\n"
+"\n"
+"   Write paths to a binary file for load_paths().  The datatype, scale,\n"
+"   bias, capabilities, paint_modes and tessellation attributes of every\n"
+"   path are kept with its data, byte for byte as it was appended.  The\n"
+"   file is written under a temporary name and renamed over `filename'.\n"
+"\n"
+"   Paints and matrices are not part of the file: a VGPath refers to\n"
+"   neither, they are context state set around each draw(), and pattern\n"
+"   paints would need their VGImage pixels saved as well.\n"
+"\n"
+"   :arg filename: File to write.\n"
+"   :type filename: str.\n"
+"   :arg paths: Paths to save.\n"
+"   :type paths: sequence of VGPath.\n"
+"\n"
+"   :error: VG_PATH_CAPABILITY_ERROR without VG_PATH_CAPABILITY_APPEND_FROM.\n"
+"   :error: RuntimeError if the data of a path is not known, see get_data().\n"
+);
+
+STATS_ENTRY(stats_SavePaths, "save_paths");
+
+PyObject *
+OpenVG_SavePaths(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+{
+    const char *filename;
+    PyObject *py_paths, *py_seq;
+    struct path_file_header header;
+    struct path_file_record *records = NULL;
+    Py_ssize_t num_paths, idx;
+    uint64_t offset;
+    FILE *file = NULL;
+    char *tmpname = NULL;
+    PyObject *py_retval = NULL;
+
+    const char *keywords[] = {"filename", "paths", NULL};
+
+    stats_scope stats(&stats_SavePaths);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "sO", (char **) keywords,
+                                     &filename, &py_paths)) {
+        return NULL;
+    }
+
+    if ((py_seq = PySequence_Fast(py_paths, "Parameter `paths' must be a sequence")) == NULL)
+        return NULL;
+    num_paths = PySequence_Fast_GET_SIZE(py_seq);
+
+    records = PyMem_New(struct path_file_record, num_paths ? num_paths : 1);
+    if (records == NULL) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    offset = sizeof(header) + num_paths * sizeof(*records);
+    for (idx = 0; idx < num_paths; idx++) {
+        PyObject *item = PySequence_Fast_GET_ITEM(py_seq, idx);
+        struct path_file_record *record = records + idx;
+        PyVGPath *path;
+
+        if (!PyObject_TypeCheck(item, &PyVGPath_Type)) {
+            PyErr_SetString(PyExc_TypeError, "Parameter `paths' must hold VGPath objects");
+            goto done;
+        }
+        path = (PyVGPath *)item;
+
+        if (!(path->capabilities & VG_PATH_CAPABILITY_APPEND_FROM)) {
+            PyErr_SetString(PyExc_ValueError, "VG_PATH_CAPABILITY_ERROR");
+            goto done;
+        }
+        if (path_datatype_size(path->datatype) == 0 || !path_coords_known(path)) {
+            PyErr_SetString(PyExc_RuntimeError,
+                            "the data of the path was not appended through VGPath");
+            goto done;
+        }
+
+        memset(record, 0, sizeof(*record));
+        record->datatype = path->datatype;
+        record->scale = path->scale;
+        record->bias = path->bias;
+        record->capabilities = path->capabilities;
+        record->paint_modes = path->paint_modes;
+        record->tessellation_tolerance = path->flat_tolerance;
+        record->tessellation_band = path->flat_band;
+        record->num_segments = path->num_segments;
+        record->num_coords = path->num_coords;
+        record->segments_offset = offset;
+        offset = PATH_FILE_ALIGN(offset + record->num_segments);
+        record->data_offset = offset;
+        offset = PATH_FILE_ALIGN(offset + (uint64_t)record->num_coords *
+                                 path_datatype_size(path->datatype));
+    }
+
+    memcpy(header.magic, PATH_FILE_MAGIC, sizeof(header.magic));
+    header.version = PATH_FILE_VERSION;
+    header.byte_order = PATH_FILE_BYTE_ORDER;
+    header.num_paths = (VGuint)num_paths;
+
+    /* written next to `filename' and renamed over it, so a failed save
+       leaves the previous file whole; loaders may have it mapped */
+    tmpname = PyMem_New(char, strlen(filename) + 32);
+    if (tmpname == NULL) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    sprintf(tmpname, "%s.%ld.tmp", filename, (long)getpid());
+
+    if ((file = fopen(tmpname, "wb")) == NULL) {
+        PyErr_SetFromErrnoWithFilename(PyExc_IOError, tmpname);
+        goto done;
+    }
+
+    offset = 0;
+    if (!path_file_write(file, &header, sizeof(header), &offset) ||
+        !path_file_write(file, records, num_paths * sizeof(*records), &offset))
+        goto write_error;
+
+    for (idx = 0; idx < num_paths; idx++) {
+        PyVGPath *path = (PyVGPath *)PySequence_Fast_GET_ITEM(py_seq, idx);
+        size_t size = (size_t)path->num_coords * path_datatype_size(path->datatype);
+
+        /* the recorded bytes are those the backend got, in the datatype */
+        if (!path_file_write(file, path->segments, path->num_segments, &offset) ||
+            !path_file_write(file, path->data, size, &offset))
+            goto write_error;
+    }
+
+    if (fclose(file) != 0) {
+        file = NULL;
+        goto write_error;
+    }
+    file = NULL;
+
+    if (rename(tmpname, filename) != 0) {
+        PyErr_SetFromErrnoWithFilename(PyExc_IOError, filename);
+        unlink(tmpname);
+        goto done;
+    }
+    stats.bytes = (Py_ssize_t)offset;
+
+    Py_INCREF(Py_None);
+    py_retval = Py_None;
+    goto done;
+
+write_error:
+    PyErr_SetFromErrnoWithFilename(PyExc_IOError, tmpname);
+    if (file != NULL)
+        fclose(file);
+    file = NULL;
+    unlink(tmpname);
+done:
+    if (file != NULL)
+        fclose(file);
+    PyMem_Free(tmpname);
+    PyMem_Free(records);
+    Py_DECREF(py_seq);
+    return py_retval;
+}
+
+/* Does the data of `record' lie within `size' bytes and match itself? */
+static const char *
+path_file_check_record(const struct path_file_record *record, const char *map,
+                       uint64_t size)
+{
+    int type_size = path_datatype_size((VGPathDatatype)record->datatype);
+    uint64_t data_size = (uint64_t)record->num_coords * type_size;
+    uint64_t coords = 0, idx;
+
+    if (type_size == 0 || record->num_segments > INT32_MAX || record->num_coords > INT32_MAX)
+        return "is corrupt";
+    if (record->segments_offset > size || record->num_segments > size - record->segments_offset)
+        return "is corrupt";
+    if (record->data_offset > size || data_size > size - record->data_offset)
+        return "is corrupt";
+    if (record->data_offset % type_size)
+        return "is corrupt";
+
+    /* only what VGPath and its setters accept */
+    if (record->capabilities & ~(VGuint)VG_PATH_CAPABILITY_ALL)
+        return "has unknown capabilities";
+    if (record->paint_modes & ~(VGuint)(VG_STROKE_PATH | VG_FILL_PATH))
+        return "has unknown paint modes";
+    if (!Py_IS_FINITE(record->tessellation_tolerance) || record->tessellation_tolerance < 0.0f)
+        return "has a tessellation_tolerance that is not finite and >= 0";
+    if (!(record->tessellation_band >= 1.0f))
+        return "has a tessellation_band that is not >= 1";
+
+    for (idx = 0; idx < record->num_segments; idx++) {
+        int n = path_segment_coords((VGubyte)map[record->segments_offset + idx]);
+
+        if (n < 0)
+            return "is corrupt";
+        coords += n;
+    }
+    return coords == record->num_coords ? NULL : "is corrupt";
+}
+
+const char OpenVG_LoadPaths__doc__[] = PyDoc_STR(
+".. function:: load_paths(filename)\n"
+"\n"
+"   Create the paths of a file written by save_paths().  The file is\n"
+"   mapped and its arrays are appended to the new paths directly.  Only\n"
+"   paths saved with VG_PATH_CAPABILITY_APPEND_FROM or a tessellation\n"
+"   tolerance keep a copy of their coordinates, see get_data().\n"
+"\n"
+"   :arg filename: File to read.\n"
+"   :type filename: str.\n"
+"   :return: The paths, in the order they were saved.\n"
+"   :rtype: list of VGPath.\n"
+"\n"
+"   :error: ValueError if the file is not a valid path file, or a path in\n"
+"      it has values VGPath would not accept; the message names the path.\n"
+"   :error: VG_OUT_OF_MEMORY_ERROR.\n"
+);
+
+STATS_ENTRY(stats_LoadPaths, "load_paths");
+
+PyObject *
+OpenVG_LoadPaths(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+{
+    const char *filename;
+    const struct path_file_header *header;
+    const struct path_file_record *records;
+    struct stat st;
+    const char *map;
+    uint64_t size;
+    VGuint idx;
+    int fd;
+    PyObject *py_retval = NULL;
+
+    const char *keywords[] = {"filename", NULL};
+
+    stats_scope stats(&stats_LoadPaths);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "s", (char **) keywords,
+                                     &filename)) {
+        return NULL;
+    }
+
+    if ((fd = open(filename, O_RDONLY)) < 0)
+        return PyErr_SetFromErrnoWithFilename(PyExc_IOError, filename);
+
+    if (fstat(fd, &st) < 0) {
+        PyErr_SetFromErrnoWithFilename(PyExc_IOError, filename);
+        close(fd);
+        return NULL;
+    }
+    size = st.st_size;
+    stats.bytes = (Py_ssize_t)size;
+
+    if (size < sizeof(*header)) {
+        close(fd);
+        PyErr_Format(PyExc_ValueError, "%s is not a path file", filename);
+        return NULL;
+    }
+
+    map = (const char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return PyErr_SetFromErrnoWithFilename(PyExc_IOError, filename);
+
+#ifdef MADV_SEQUENTIAL
+    madvise((void *)map, size, MADV_SEQUENTIAL);
+#endif
+
+    header = (const struct path_file_header *)map;
+    records = (const struct path_file_record *)(header + 1);
+
+    if (memcmp(header->magic, PATH_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != PATH_FILE_VERSION ||
+        header->byte_order != PATH_FILE_BYTE_ORDER ||
+        header->num_paths > (size - sizeof(*header)) / sizeof(*records)) {
+        PyErr_Format(PyExc_ValueError, "%s is not a path file of this machine", filename);
+        goto done;
+    }
+
+    for (idx = 0; idx < header->num_paths; idx++) {
+        const char *problem = path_file_check_record(records + idx, map, size);
+
+        if (problem != NULL) {
+            PyErr_Format(PyExc_ValueError, "%s: path %u %s", filename, idx, problem);
+            goto done;
+        }
+    }
+
+    if ((py_retval = PyList_New(header->num_paths)) == NULL)
+        goto done;
+
+    for (idx = 0; idx < header->num_paths; idx++) {
+        const struct path_file_record *record = records + idx;
+        const VGubyte *segments = (const VGubyte *)map + record->segments_offset;
+        const void *data = map + record->data_offset;
+        PyVGPath *path;
+
+        path = path_create((VGPathDatatype)record->datatype, record->scale, record->bias,
+                           record->num_segments, record->num_coords, record->capabilities);
+        if (path == NULL) {
+            Py_CLEAR(py_retval);
+            goto done;
+        }
+        PyList_SET_ITEM(py_retval, idx, (PyObject *)path);
+
+        path->paint_modes = record->paint_modes;
+        path->flat_tolerance = record->tessellation_tolerance;
+        path->flat_band = record->tessellation_band;
+
+        if (record->num_segments == 0)
+            continue;
+
+        VG_BEGIN_ALLOW_THREADS
+        vgAppendPathData(path->obj, record->num_segments, segments, data);
+        VG_END_ALLOW_THREADS
+
+        if (check_error()) {
+            Py_CLEAR(py_retval);
+            goto done;
+        }
+
+        if (path_forget_unchecked(path))
+            continue;
+
+        path_record_segments(path, segments, record->num_segments);
+        path_record_data(path, data, record->num_coords, record->num_segments);
+    }
+
+done:
+    munmap((void *)map, size);
+    return py_retval;
+}
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2012 Dan Eicher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file COPYING;
+ * if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * VGRenderTarget is the context manager returned by VGContext.target().
+ * ShivaVG has no API to draw into an image, so the image is copied onto
+ * a drawing surface on entry and copied back on exit.  Headless contexts
+ * bind a fresh surface of the image size; GL contexts borrow the lower
+ * left corner of their surface and put the pixels they drew over back.
+ * Each target restores what the one entered before it bound, so targets
+ * must be left in the reverse order; a GL context's surface corner holds
+ * one target at a time.
+ */
+
+#include "openvg_module.h"
+
+/* Undo what __enter__ set up, leaving the image alone. */
+static int
+render_target_restore(PyVGRenderTarget *self)
+{
+    int retval = 0;
+
+    if (self->pixels != NULL) {
+        retval = context_bind_target(self->context, self->previous,
+                                     self->previous_dimensions[0],
+                                     self->previous_dimensions[1]);
+        PyMem_Free(self->pixels);
+        self->pixels = NULL;
+    }
+
+    if (self->scissor_rects != NULL) {
+        backend_wait();
+        vgSetiv(VG_SCISSOR_RECTS, self->num_scissor_rects, self->scissor_rects);
+        vgSeti(VG_SCISSORING, self->scissoring);
+        PyMem_Free(self->scissor_rects);
+        self->scissor_rects = NULL;
+    }
+
+    if (self->saved != VG_INVALID_HANDLE) {
+        vgSetPixels(0, 0, self->saved, 0, 0, self->width, self->height);
+        vgDestroyImage(self->saved);
+        self->saved = VG_INVALID_HANDLE;
+    }
+
+    self->active = false;
+    self->context->targets--;
+    return retval;
+}
+
+static PyObject *
+PyVGRenderTarget__enter__(PyVGRenderTarget *self)
+{
+    PyVGContext *context = self->context;
+
+    if (self->active) {
+        PyErr_SetString(PyExc_RuntimeError, "render target is already active");
+        return NULL;
+    }
+
+    if (get_current_context() != context) {
+        PyErr_SetString(PyExc_RuntimeError, "VGContext is not current");
+        return NULL;
+    }
+
+    if (!context->headless && context->targets > 0) {
+        PyErr_SetString(PyExc_RuntimeError,
+            "a GL VGContext draws into one render target at a time");
+        return NULL;
+    }
+
+    backend_wait();
+    self->width = vgGetParameteri(self->image->obj, VG_IMAGE_WIDTH);
+    self->height = vgGetParameteri(self->image->obj, VG_IMAGE_HEIGHT);
+
+    if (check_error()) {
+        return NULL;
+    }
+
+    self->active = true;
+    self->depth = ++context->targets;
+
+    if (context->headless) {
+        self->pixels = (unsigned char *)PyMem_Malloc((size_t)self->width * self->height * 4);
+        if (self->pixels == NULL) {
+            render_target_restore(self);
+            return PyErr_NoMemory();
+        }
+
+        self->previous = context->target;
+        self->previous_dimensions[0] = context->target_dimensions[0];
+        self->previous_dimensions[1] = context->target_dimensions[1];
+
+        if (context_bind_target(context, self->pixels, self->width, self->height) < 0) {
+            render_target_restore(self);
+            return NULL;
+        }
+    }
+    else {
+        VGint rect[4] = {0, 0, self->width, self->height};
+        VGint count;
+
+        if (self->width > context->dimensions[0] || self->height > context->dimensions[1]) {
+            render_target_restore(self);
+            PyErr_SetString(PyExc_ValueError,
+                "render target image is larger than the drawing surface");
+            return NULL;
+        }
+
+        count = vgGetVectorSize(VG_SCISSOR_RECTS);
+        self->scissor_rects = PyMem_New(VGint, count > 0 ? count : 1);
+        if (self->scissor_rects == NULL) {
+            render_target_restore(self);
+            return PyErr_NoMemory();
+        }
+        self->num_scissor_rects = count;
+        vgGetiv(VG_SCISSOR_RECTS, count, self->scissor_rects);
+        self->scissoring = vgGeti(VG_SCISSORING);
+
+        self->saved = vgCreateImage(VG_sRGBA_8888_PRE, self->width, self->height,
+                                    VG_IMAGE_QUALITY_NONANTIALIASED);
+        if (self->saved != VG_INVALID_HANDLE)
+            vgGetPixels(self->saved, 0, 0, 0, 0, self->width, self->height);
+
+        vgSetiv(VG_SCISSOR_RECTS, 4, rect);
+        vgSeti(VG_SCISSORING, VG_TRUE);
+    }
+
+    vgSetPixels(0, 0, self->image->obj, 0, 0, self->width, self->height);
+
+    if (check_error()) {
+        render_target_restore(self);
+        return NULL;
+    }
+
+    Py_INCREF(self->image);
+    return (PyObject *)self->image;
+}
+
+static PyObject *
+PyVGRenderTarget__exit__(PyVGRenderTarget *self, PyObject *args)
+{
+    bool failed;
+
+    if (!self->active) {
+        PyErr_SetString(PyExc_RuntimeError, "render target is not active");
+        return NULL;
+    }
+
+    if (self->depth != self->context->targets) {
+        PyErr_SetString(PyExc_RuntimeError,
+            "render targets must be left in the reverse order they were entered");
+        return NULL;
+    }
+
+    /* leave the image untouched when the block raised */
+    backend_wait();
+    if (PyTuple_GET_SIZE(args) == 0 || PyTuple_GET_ITEM(args, 0) == Py_None)
+        vgGetPixels(self->image->obj, 0, 0, 0, 0, self->width, self->height);
+
+    failed = render_target_restore(self) < 0;
+
+    if (failed || check_error()) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef PyVGRenderTarget_methods[] = {
+    {(char *) "__enter__",
+     (PyCFunction) PyVGRenderTarget__enter__,
+     METH_NOARGS,
+     NULL
+    },
+    {(char *) "__exit__",
+     (PyCFunction) PyVGRenderTarget__exit__,
+     METH_VARARGS,
+     NULL
+    },
+    {NULL, NULL, 0, NULL}
+};
+
+static void
+PyVGRenderTarget__tp_dealloc(PyVGRenderTarget *self)
+{
+    if (self->active)
+        render_target_restore(self);
+
+    Py_DECREF(self->context);
+    Py_DECREF(self->image);
+
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+PyDoc_STRVAR(PyVGRenderTarget__doc__,
+".. class:: VGRenderTarget\n"
+"\n"
+"   Context manager returned by VGContext.target(), drawing into an image.\n"
+"\n"
+"   Each block copies the whole image area: a headless context copies the\n"
+"   image to its surface on entry and back on exit, two copies.  A GL\n"
+"   context also saves the corner of its surface it draws over and puts\n"
+"   it back, four copies.  Targets must be left in the reverse order they\n"
+"   were entered, RuntimeError otherwise.  A GL context draws into one\n"
+"   target at a time, entering a second raises RuntimeError; headless\n"
+"   targets nest.\n"
+);
+
+PyTypeObject PyVGRenderTarget_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    (char *) "VG.VGRenderTarget",              /* tp_name */
+    sizeof(PyVGRenderTarget),                      /* tp_basicsize */
+    0,                                             /* tp_itemsize */
+    /* methods */
+    (destructor)PyVGRenderTarget__tp_dealloc,      /* tp_dealloc */
+    (printfunc)0,                                  /* tp_print */
+    (getattrfunc)NULL,                             /* tp_getattr */
+    (setattrfunc)NULL,                             /* tp_setattr */
+    (cmpfunc)NULL,                                 /* tp_compare */
+    (reprfunc)NULL,                                /* tp_repr */
+    (PyNumberMethods*)NULL,                        /* tp_as_number */
+    (PySequenceMethods*)NULL,                      /* tp_as_sequence */
+    (PyMappingMethods*)NULL,                       /* tp_as_mapping */
+    (hashfunc)NULL,                                /* tp_hash */
+    (ternaryfunc)NULL,                             /* tp_call */
+    (reprfunc)NULL,                                /* tp_str */
+    (getattrofunc)NULL,                            /* tp_getattro */
+    (setattrofunc)NULL,                            /* tp_setattro */
+    (PyBufferProcs*)NULL,                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                            /* tp_flags */
+    PyVGRenderTarget__doc__,                       /* Documentation string */
+    (traverseproc)NULL,                            /* tp_traverse */
+    (inquiry)NULL,                                 /* tp_clear */
+    (richcmpfunc)NULL,                             /* tp_richcompare */
+    0,                                             /* tp_weaklistoffset */
+    (getiterfunc)NULL,                             /* tp_iter */
+    (iternextfunc)NULL,                            /* tp_iternext */
+    (struct PyMethodDef*)PyVGRenderTarget_methods, /* tp_methods */
+    (struct PyMemberDef*)0,                        /* tp_members */
+    NULL,                                          /* tp_getset */
+    NULL,                                          /* tp_base */
+    NULL,                                          /* tp_dict */
+    (descrgetfunc)NULL,                            /* tp_descr_get */
+    (descrsetfunc)NULL,                            /* tp_descr_set */
+    0,                                             /* tp_dictoffset */
+    (initproc)NULL,                                /* tp_init */
+    (allocfunc)PyType_GenericAlloc,                /* tp_alloc */
+    (newfunc)NULL,                                 /* tp_new */
+    (freefunc)0,                                   /* tp_free */
+    (inquiry)NULL,                                 /* tp_is_gc */
+    NULL,                                          /* tp_bases */
+    NULL,                                          /* tp_mro */
+    NULL,                                          /* tp_cache */
+    NULL,                                          /* tp_subclasses */
+    NULL,                                          /* tp_weaklist */
+    (destructor) NULL                              /* tp_del */
+};
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2012 Dan Eicher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file COPYING;
+ * if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * Call statistics of VG.stats().  Entries are updated with the GIL held,
+ * when their stats_scope ends, and linked into a list on their first
+ * call.  Wall times go into a log-linear histogram of nanoseconds with
+ * four buckets per power of two, which percentiles are read from, so they
+ * are accurate to about 12%.
+ */
+
+#include "openvg_module.h"
+#include <time.h>
+
+bool stats_enabled = false;
+static struct stats_entry *stats_entries = NULL;
+
+double
+stats_clock(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static int
+stats_bucket(double seconds)
+{
+    unsigned long long ns = seconds > 0.0 ? (unsigned long long)(seconds * 1e9) : 0;
+    int exponent = 0;
+
+    if (ns < 4)
+        return (int)ns;
+
+    while ((ns >> exponent) > 1)
+        exponent++;
+
+    return 4 * (exponent - 1) + (int)((ns >> (exponent - 2)) & 3);
+}
+
+/* Middle of `bucket', in seconds. */
+static double
+stats_bucket_value(int bucket)
+{
+    int exponent = bucket / 4 + 1;
+
+    if (bucket < 4)
+        return bucket * 1e-9;
+
+    return ((4 + bucket % 4) + 0.5) * (double)(1ULL << (exponent - 2)) * 1e-9;
+}
+
+void
+stats_record(struct stats_entry *entry, double start, Py_ssize_t bytes, bool failed)
+{
+    double seconds = stats_clock() - start;
+
+    if (!entry->listed) {
+        entry->next = stats_entries;
+        stats_entries = entry;
+        entry->listed = true;
+    }
+
+    entry->calls++;
+    if (failed)
+        entry->errors++;
+    if (bytes > 0)
+        entry->bytes += bytes;
+    entry->seconds += seconds;
+    if (seconds > entry->max)
+        entry->max = seconds;
+    entry->buckets[stats_bucket(seconds)]++;
+}
+
+void
+stats_scope::end(void)
+{
+    bool failed = PyErr_Occurred() != NULL;
+
+    if (stats_enabled)
+        stats_record(entry, start, bytes, failed);
+    if (trace_enabled)
+        trace_record(entry->name, start, stats_clock(), handle, bytes, failed);
+}
+
+static double
+stats_percentile(struct stats_entry *entry, double fraction)
+{
+    unsigned long long rank = (unsigned long long)(fraction * entry->calls + 0.5);
+    unsigned long long seen = 0;
+    int bucket;
+
+    if (rank < 1)
+        rank = 1;
+
+    for (bucket = 0; bucket < STATS_BUCKETS; bucket++) {
+        seen += entry->buckets[bucket];
+        if (seen >= rank) {
+            double value = stats_bucket_value(bucket);
+            return value < entry->max ? value : entry->max;
+        }
+    }
+    return entry->max;
+}
+
+const char OpenVG_Stats__doc__[] = PyDoc_STR(
+".. function:: stats()\n"
+"\n"
+"   Statistics of the calls made while enable_stats() was on, per entry\n"
+"   point called at least once.  Times are wall times in seconds, the\n"
+"   percentiles are accurate to about 12%.  `errors' counts the calls\n"
+"   that raised; while errors are deferred (defer_errors()) a failing call\n"
+"   doesn't raise, the error is counted on the call that reports it.\n"
+"\n"
+"   :return: {name: {'calls', 'errors', 'bytes', 'seconds', 'mean', 'p50',\n"
+"      'p90', 'p99', 'max'}}, `bytes' counts pixel and path data marshalled.\n"
+"   :rtype: dict\n"
+);
+
+PyObject *
+OpenVG_Stats(PyObject * UNUSED(dummy))
+{
+    PyObject *py_retval = PyDict_New();
+    struct stats_entry *entry;
+
+    if (py_retval == NULL)
+        return NULL;
+
+    for (entry = stats_entries; entry != NULL; entry = entry->next) {
+        PyObject *py_entry;
+
+        if (entry->calls == 0)
+            continue;
+
+        py_entry = Py_BuildValue((char *) "{s:K,s:K,s:K,s:d,s:d,s:d,s:d,s:d,s:d}",
+                                 "calls", entry->calls,
+                                 "errors", entry->errors,
+                                 "bytes", entry->bytes,
+                                 "seconds", entry->seconds,
+                                 "mean", entry->seconds / entry->calls,
+                                 "p50", stats_percentile(entry, 0.50),
+                                 "p90", stats_percentile(entry, 0.90),
+                                 "p99", stats_percentile(entry, 0.99),
+                                 "max", entry->max);
+        if (py_entry == NULL || PyDict_SetItemString(py_retval, entry->name, py_entry) < 0) {
+            Py_XDECREF(py_entry);
+            Py_DECREF(py_retval);
+            return NULL;
+        }
+        Py_DECREF(py_entry);
+    }
+
+    return py_retval;
+}
+
+const char OpenVG_ResetStats__doc__[] = PyDoc_STR(
+".. function:: reset_stats()\n"
+"\n"
+"   Forget the statistics gathered so far.\n"
+);
+
+PyObject *
+OpenVG_ResetStats(PyObject * UNUSED(dummy))
+{
+    struct stats_entry *entry;
+
+    for (entry = stats_entries; entry != NULL; entry = entry->next) {
+        entry->calls = 0;
+        entry->errors = 0;
+        entry->bytes = 0;
+        entry->seconds = 0.0;
+        entry->max = 0.0;
+        memset(entry->buckets, 0, sizeof(entry->buckets));
+    }
+
+    Py_RETURN_NONE;
+}
+
+const char OpenVG_EnableStats__doc__[] = PyDoc_STR(
+".. function:: enable_stats([enabled])\n"
+"\n"
+"   Turn gathering statistics for stats() on or off, it is off by default\n"
+"   and costs a flag test per call then.\n"
+"\n"
+"   :arg enabled: Gather statistics, default True.\n"
+"   :type enabled: bool\n"
+"   :return: Whether statistics were gathered before.\n"
+"   :rtype: bool\n"
+);
+
+PyObject *
+OpenVG_EnableStats(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+{
+    PyObject *py_enabled = Py_True;
+    bool previous = stats_enabled;
+    int enabled;
+
+    const char *keywords[] = {"enabled", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "|O", (char **) keywords, &py_enabled)) {
+        return NULL;
+    }
+
+    if ((enabled = PyObject_IsTrue(py_enabled)) < 0)
+        return NULL;
+
+    stats_enabled = enabled;
+
+    return PyBool_FromLong(previous);
+}
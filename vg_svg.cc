@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2012 Dan Eicher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file COPYING;
+ * if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * Parser of SVG path data (the `d' attribute) used by VGPath.append_svg().
+ * Every SVG command has an OpenVG segment with the same meaning, relative
+ * forms included, so commands are translated one to one and the
+ * coordinates are kept as written.  The exception is smooth curves: SVG
+ * only reflects the control point of a curve of the same kind, OpenVG
+ * that of any curve, so S and T after anything else become a full curve
+ * whose first control point is the current point.
+ */
+
+#include "openvg_module.h"
+
+#define SVG_MAX_NUMBER 64
+
+static bool
+svg_is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+static bool
+svg_is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/* Skip white space and at most one comma. */
+static const char *
+svg_skip(const char *p, const char *end)
+{
+    while (p < end && svg_is_space(*p))
+        p++;
+    if (p < end && *p == ',') {
+        p++;
+        while (p < end && svg_is_space(*p))
+            p++;
+    }
+    return p;
+}
+
+static bool
+svg_number(const char **pp, const char *end, VGfloat *value)
+{
+    const char *start = svg_skip(*pp, end), *p = start;
+    char buffer[SVG_MAX_NUMBER];
+    int digits = 0;
+    double number;
+
+    if (p < end && (*p == '+' || *p == '-'))
+        p++;
+    while (p < end && svg_is_digit(*p)) {
+        p++;
+        digits++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && svg_is_digit(*p)) {
+            p++;
+            digits++;
+        }
+    }
+    if (digits == 0)
+        return false;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+
+        if (q < end && (*q == '+' || *q == '-'))
+            q++;
+        if (q < end && svg_is_digit(*q)) {
+            while (q < end && svg_is_digit(*q))
+                q++;
+            p = q;
+        }
+    }
+
+    if (p - start >= SVG_MAX_NUMBER)
+        return false;
+
+    memcpy(buffer, start, p - start);
+    buffer[p - start] = '\0';
+
+    number = PyOS_string_to_double(buffer, NULL, NULL);
+    if (number == -1.0 && PyErr_Occurred())
+        return false;
+
+    *value = (VGfloat)number;
+    *pp = p;
+    return true;
+}
+
+/* Arc flags are a single digit and need no separator. */
+static bool
+svg_flag(const char **pp, const char *end, bool *flag)
+{
+    const char *p = svg_skip(*pp, end);
+
+    if (p >= end || (*p != '0' && *p != '1'))
+        return false;
+
+    *flag = *p == '1';
+    *pp = p + 1;
+    return true;
+}
+
+/*
+ * Parse `length' chars of `d' into `segments' and `coords', which must have
+ * room for `length' entries each: every segment and every coordinate takes
+ * at least one char, an S or T made a full curve pays for its extra
+ * control point with separators.  Returns -1, or the offset of the first
+ * error.
+ */
+Py_ssize_t
+path_parse_svg(const char *d, Py_ssize_t length, VGubyte *segments,
+               VGfloat *coords, VGint *num_segments, VGint *num_coords)
+{
+    const char *p = d, *end = d + length;
+    VGubyte *segment = segments;
+    VGfloat *coord = coords;
+    VGfloat px = 0, py = 0, sx = 0, sy = 0;     /* current point, subpath start */
+    char command = 0, previous = 0;
+
+    while (true) {
+        const char *token;
+        VGubyte relative;
+        VGfloat ox, oy;
+        int idx, count = 0;
+
+        while (p < end && svg_is_space(*p))
+            p++;
+        if (p >= end)
+            break;
+
+        token = p;
+        if (strchr("MmZzLlHhVvCcSsQqTtAa", *p) != NULL) {
+            command = *p++;
+        }
+        else if (command == 0 || command == 'Z' || command == 'z') {
+            return token - d;
+        }
+        else if (command == 'M' || command == 'm') {
+            /* coordinate pairs after a moveto are implicit linetos */
+            command = command == 'M' ? 'L' : 'l';
+        }
+
+        /* path data starts with a moveto, which makes the current point known */
+        if (segment == segments && command != 'M' && command != 'm')
+            return token - d;
+
+        relative = command >= 'a' ? VG_RELATIVE : VG_ABSOLUTE;
+        ox = relative ? px : 0;
+        oy = relative ? py : 0;
+
+        switch (command) {
+            case 'Z':
+            case 'z':
+                *segment++ = VG_CLOSE_PATH;
+                px = sx;
+                py = sy;
+                previous = 'Z';
+                continue;
+            case 'M':
+            case 'm':
+                /* the first moveto of path data is absolute either way */
+                if (segment == segments) {
+                    relative = VG_ABSOLUTE;
+                    ox = oy = 0;
+                }
+                *segment++ = VG_MOVE_TO | relative;
+                count = 2;
+                break;
+            case 'L':
+            case 'l':
+                *segment++ = VG_LINE_TO | relative;
+                count = 2;
+                break;
+            case 'H':
+            case 'h':
+                *segment++ = VG_HLINE_TO | relative;
+                count = 1;
+                break;
+            case 'V':
+            case 'v':
+                *segment++ = VG_VLINE_TO | relative;
+                count = 1;
+                break;
+            case 'C':
+            case 'c':
+                *segment++ = VG_CUBIC_TO | relative;
+                count = 6;
+                break;
+            case 'S':
+            case 's':
+                if (previous == 'C' || previous == 'S') {
+                    *segment++ = VG_SCUBIC_TO | relative;
+                }
+                else {
+                    *segment++ = VG_CUBIC_TO | relative;
+                    *coord++ = px - ox;
+                    *coord++ = py - oy;
+                }
+                count = 4;
+                break;
+            case 'Q':
+            case 'q':
+                *segment++ = VG_QUAD_TO | relative;
+                count = 4;
+                break;
+            case 'T':
+            case 't':
+                if (previous == 'Q' || previous == 'T') {
+                    *segment++ = VG_SQUAD_TO | relative;
+                }
+                else {
+                    *segment++ = VG_QUAD_TO | relative;
+                    *coord++ = px - ox;
+                    *coord++ = py - oy;
+                }
+                count = 2;
+                break;
+            case 'A':
+            case 'a': {
+                bool large, sweep;
+
+                /* rx ry x-axis-rotation large-arc-flag sweep-flag x y */
+                if (!svg_number(&p, end, coord++) ||
+                    !svg_number(&p, end, coord++) ||
+                    !svg_number(&p, end, coord++) ||
+                    !svg_flag(&p, end, &large) ||
+                    !svg_flag(&p, end, &sweep) ||
+                    !svg_number(&p, end, coord++) ||
+                    !svg_number(&p, end, coord++)) {
+                    return (p > token ? p : token) - d;
+                }
+                /* a positive-angle sweep is counterclockwise in OpenVG */
+                *segment++ = (large ? (sweep ? VG_LCCWARC_TO : VG_LCWARC_TO) :
+                                      (sweep ? VG_SCCWARC_TO : VG_SCWARC_TO)) | relative;
+                px = coord[-2] + ox;
+                py = coord[-1] + oy;
+                previous = 'A';
+                continue;
+            }
+        }
+
+        for (idx = 0; idx < count; idx++) {
+            if (!svg_number(&p, end, coord++))
+                return (p > token ? p : token) - d;
+        }
+
+        switch (command) {
+            case 'H':
+            case 'h':
+                px = coord[-1] + ox;
+                break;
+            case 'V':
+            case 'v':
+                py = coord[-1] + oy;
+                break;
+            default:
+                px = coord[-2] + ox;
+                py = coord[-1] + oy;
+                break;
+        }
+        if (command == 'M' || command == 'm') {
+            sx = px;
+            sy = py;
+        }
+        previous = command & ~0x20;     /* upper case */
+    }
+
+    *num_segments = (VGint)(segment - segments);
+    *num_coords = (VGint)(coord - coords);
+    return -1;
+}
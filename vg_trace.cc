@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2012 Dan Eicher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file COPYING;
+ * if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * Tracer of VG.start_trace().  The stats_scope of every instrumented call
+ * adds an event to a fixed ring buffer, overwriting the oldest once it is
+ * full; nothing is formatted until dump_trace() writes the buffer out as
+ * Chrome trace-event JSON, which chrome://tracing and Perfetto load.
+ * Events are added with the GIL held.
+ */
+
+#include "openvg_module.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "pythread.h"
+
+#define TRACE_DEFAULT_CAPACITY 65536
+
+struct trace_event {
+    const char *name;
+    double start;
+    double end;
+    VGHandle handle;
+    Py_ssize_t bytes;
+    unsigned long thread;
+    bool failed;
+};
+
+bool trace_enabled = false;
+static struct trace_event *trace_events = NULL;
+static Py_ssize_t trace_capacity = 0;
+static Py_ssize_t trace_next = 0;           /* slot the next event goes to */
+static unsigned long long trace_count = 0;  /* events since start_trace() */
+static double trace_epoch = 0.0;
+
+void
+trace_record(const char *name, double start, double end, VGHandle handle,
+             Py_ssize_t bytes, bool failed)
+{
+    struct trace_event *event;
+
+    if (trace_capacity == 0)
+        return;
+
+    event = trace_events + trace_next;
+    event->name = name;
+    event->start = start;
+    event->end = end;
+    event->handle = handle;
+    event->bytes = bytes;
+    event->thread = PyThread_get_thread_ident();
+    event->failed = failed;
+
+    if (++trace_next == trace_capacity)
+        trace_next = 0;
+    trace_count++;
+}
+
+const char OpenVG_StartTrace__doc__[] = PyDoc_STR(
+".. function:: start_trace([capacity])\n"
+"\n"
+"   Start tracing the instrumented calls (those of stats()) into a ring\n"
+"   buffer of `capacity' events, dropping the events of a previous trace.\n"
+"   Once full, the oldest events are overwritten.\n"
+"\n"
+"   :arg capacity: Number of events kept, default 65536.\n"
+"   :type capacity: int\n"
+);
+
+PyObject *
+OpenVG_StartTrace(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+{
+    Py_ssize_t capacity = TRACE_DEFAULT_CAPACITY;
+
+    const char *keywords[] = {"capacity", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "|n", (char **) keywords, &capacity)) {
+        return NULL;
+    }
+
+    if (capacity < 1) {
+        PyErr_SetString(PyExc_ValueError, "capacity must be at least 1");
+        return NULL;
+    }
+
+    if (capacity != trace_capacity) {
+        struct trace_event *events = trace_events;
+
+        trace_capacity = 0;
+        if (PyMem_Resize(events, struct trace_event, capacity) == NULL) {
+            trace_enabled = false;
+            return PyErr_NoMemory();
+        }
+        trace_events = events;
+    }
+
+    trace_capacity = capacity;
+    trace_next = 0;
+    trace_count = 0;
+    trace_epoch = stats_clock();
+    trace_enabled = true;
+
+    Py_RETURN_NONE;
+}
+
+const char OpenVG_StopTrace__doc__[] = PyDoc_STR(
+".. function:: stop_trace()\n"
+"\n"
+"   Stop tracing, keeping the events for dump_trace().\n"
+);
+
+PyObject *
+OpenVG_StopTrace(PyObject * UNUSED(dummy))
+{
+    trace_enabled = false;
+
+    Py_RETURN_NONE;
+}
+
+/* Append to a growing string, false when out of memory. */
+static bool
+trace_printf(char **buffer, size_t *length, size_t *size, const char *format, ...)
+{
+    va_list args;
+    int needed;
+
+    while (true) {
+        va_start(args, format);
+        needed = vsnprintf(*buffer + *length, *size - *length, format, args);
+        va_end(args);
+
+        if (needed < 0)
+            return false;
+        if ((size_t)needed < *size - *length)
+            break;
+
+        {
+            size_t size_new = (*size + needed) * 2;
+            char *tmp = *buffer;
+
+            if (PyMem_Resize(tmp, char, size_new) == NULL)
+                return false;
+            *buffer = tmp;
+            *size = size_new;
+        }
+    }
+
+    *length += needed;
+    return true;
+}
+
+const char OpenVG_DumpTrace__doc__[] = PyDoc_STR(
+".. function:: dump_trace([filename])\n"
+"\n"
+"   Write the traced events as Chrome trace-event JSON, for\n"
+"   chrome://tracing or Perfetto.  Each call is a complete event with the\n"
+"   handle of the object it worked on, the bytes it marshalled and\n"
+"   whether it failed; otherData.dropped counts overwritten events.\n"
+"\n"
+"   :arg filename: File to write, or None to return the JSON.\n"
+"   :type filename: str\n"
+"   :return: The JSON without `filename'.\n"
+"   :rtype: str or None\n"
+);
+
+PyObject *
+OpenVG_DumpTrace(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+{
+    const char *filename = NULL;
+    size_t length = 0, size = 4096;
+    char *buffer;
+    Py_ssize_t idx, count, first;
+    long pid = (long)getpid();
+    PyObject *py_retval = NULL;
+    bool ok;
+
+    const char *keywords[] = {"filename", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "|z", (char **) keywords, &filename)) {
+        return NULL;
+    }
+
+    if ((buffer = PyMem_New(char, size)) == NULL)
+        return PyErr_NoMemory();
+
+    count = trace_count < (unsigned long long)trace_capacity ?
+            (Py_ssize_t)trace_count : trace_capacity;
+    first = count < trace_capacity ? 0 : trace_next;
+
+    ok = trace_printf(&buffer, &length, &size, "{\"traceEvents\":[");
+
+    for (idx = 0; ok && idx < count; idx++) {
+        const struct trace_event *event = trace_events + (first + idx) % trace_capacity;
+
+        ok = trace_printf(&buffer, &length, &size,
+                          "%s\n{\"name\":\"%s\",\"cat\":\"VG\",\"ph\":\"X\","
+                          "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%ld,\"tid\":%lu,"
+                          "\"args\":{\"handle\":\"%#lx\",\"bytes\":%zd,\"error\":%s}}",
+                          idx ? "," : "", event->name,
+                          (event->start - trace_epoch) * 1e6,
+                          (event->end - event->start) * 1e6,
+                          pid, event->thread, (unsigned long)(size_t)event->handle, event->bytes,
+                          event->failed ? "true" : "false");
+    }
+
+    if (ok)
+        ok = trace_printf(&buffer, &length, &size,
+                          "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":%llu}}\n",
+                          trace_count - count);
+
+    if (!ok) {
+        PyMem_Free(buffer);
+        return PyErr_NoMemory();
+    }
+
+    if (filename == NULL) {
+        py_retval = Py_BuildValue((char *) "s#", buffer, (Py_ssize_t)length);
+    }
+    else {
+        FILE *file = fopen(filename, "w");
+
+        if (file == NULL || fwrite(buffer, 1, length, file) != length) {
+            PyErr_SetFromErrnoWithFilename(PyExc_IOError, filename);
+            if (file != NULL)
+                fclose(file);
+        }
+        else if (fclose(file) != 0) {
+            PyErr_SetFromErrnoWithFilename(PyExc_IOError, filename);
+        }
+        else {
+            Py_INCREF(Py_None);
+            py_retval = Py_None;
+        }
+    }
+
+    PyMem_Free(buffer);
+    return py_retval;
+}
@@ -21,6 +21,30 @@
 #include "openvg_module.h"
 #include "vgu.h"
 
+/*
+ * Segments appended by the VGU helpers as laid out in the OpenVG
+ * specification, recorded on the path so modify_coords() can be checked.
+ * path_verify_segments() drops them if the implementation differs.
+ */
+static const VGubyte line_segments[] = {
+    VG_MOVE_TO_ABS, VG_LINE_TO_ABS
+};
+static const VGubyte polygon_segments[] = {
+    VG_MOVE_TO_ABS, VG_LINE_TO_ABS, VG_CLOSE_PATH
+};
+static const VGubyte rect_segments[] = {
+    VG_MOVE_TO_ABS, VG_HLINE_TO_REL, VG_VLINE_TO_REL, VG_HLINE_TO_REL,
+    VG_CLOSE_PATH
+};
+static const VGubyte round_rect_segments[] = {
+    VG_MOVE_TO_ABS, VG_HLINE_TO_REL, VG_SCCWARC_TO_REL, VG_VLINE_TO_REL,
+    VG_SCCWARC_TO_REL, VG_HLINE_TO_REL, VG_SCCWARC_TO_REL, VG_VLINE_TO_REL,
+    VG_SCCWARC_TO_REL, VG_CLOSE_PATH
+};
+static const VGubyte ellipse_segments[] = {
+    VG_MOVE_TO_ABS, VG_SCCWARC_TO_REL, VG_SCCWARC_TO_REL, VG_CLOSE_PATH
+};
+
 /* --- module functions --- */
 
 static void vgu_error(VGUErrorCode error)
@@ -48,45 +72,66 @@ static void vgu_error(VGUErrorCode error)
     }
 }
 
+static const char *const VGU_vguArc_keywords[] = {"path", "x", "y", "width", "height", "startAngle", "angleExtent", "arcType", NULL};
+static const struct fast_parser VGU_vguArc_parser = {"arc", VGU_vguArc_keywords, 8, 8};
+
 static PyObject *
-VGU_vguArc(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+VGU_vguArc(PyObject * UNUSED(dummy), FAST_ARGS)
 {
+    PyObject *argv[8];
     VGUErrorCode error;
     PyVGPath *path;
     VGfloat x, y, width, height;
     VGfloat startAngle, angleExtent;
-    VGUArcType arcType;
-
-    const char *keywords[] = {"path", "x", "y", "width", "height",
-                              "startAngle", "angleExtent", "arcType", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!ffffffi", (char **) keywords, &PyVGPath_Type, &path, &x, &y, &width, &height, &startAngle, &angleExtent, &arcType)) {
+    VGint arcType;
+
+    if (!fast_unpack(FAST_PASS, &VGU_vguArc_parser, argv) ||
+        !fast_object(argv[0], &PyVGPath_Type, &path) ||
+        !fast_float(argv[1], &x) ||
+        !fast_float(argv[2], &y) ||
+        !fast_float(argv[3], &width) ||
+        !fast_float(argv[4], &height) ||
+        !fast_float(argv[5], &startAngle) ||
+        !fast_float(argv[6], &angleExtent) ||
+        !fast_int(argv[7], &arcType)) {
         return NULL;
     }
 
-    error = vguArc(path->obj, x, y, width, height, startAngle, angleExtent, arcType);
+    backend_wait();
+    error = vguArc(path->obj, x, y, width, height, startAngle, angleExtent, (VGUArcType)arcType);
 
     if (error) {
         vgu_error(error);
         return NULL;
     }
 
+    /* the number of arc segments is up to the implementation */
+    path_forget_segments(path);
+
     Py_RETURN_NONE;
 }
 
+static const char *const VGU_vguLine_keywords[] = {"path", "x0", "y0", "x1", "y1", NULL};
+static const struct fast_parser VGU_vguLine_parser = {"line", VGU_vguLine_keywords, 5, 5};
+
 static PyObject *
-VGU_vguLine(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+VGU_vguLine(PyObject * UNUSED(dummy), FAST_ARGS)
 {
+    PyObject *argv[5];
     VGUErrorCode error;
     PyVGPath *path;
     VGfloat x0, y0, x1, y1;
 
-    const char *keywords[] = {"path", "x0", "y0", "x1", "y1", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!ffff", (char **) keywords, &PyVGPath_Type, &path, &x0, &y0, &x1, &y1)) {
+    if (!fast_unpack(FAST_PASS, &VGU_vguLine_parser, argv) ||
+        !fast_object(argv[0], &PyVGPath_Type, &path) ||
+        !fast_float(argv[1], &x0) ||
+        !fast_float(argv[2], &y0) ||
+        !fast_float(argv[3], &x1) ||
+        !fast_float(argv[4], &y1)) {
         return NULL;
     }
 
+    backend_wait();
     error = vguLine(path->obj, x0, y0, x1, y1);
 
     if (error) {
@@ -94,6 +139,9 @@ VGU_vguLine(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
         return NULL;
     }
 
+    path_record_segments(path, line_segments, sizeof(line_segments));
+    path_verify_segments(path);
+
     Py_RETURN_NONE;
 }
 
@@ -111,7 +159,7 @@ VGU_vguPolygon(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
 
     const char *keywords[] = {"path", "points", "closed", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!O!O", (char **) keywords, &PyVGPath_Type, &path, &PyList_Type, &py_list, &count, &py_closed)) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!O!O", (char **) keywords, &PyVGPath_Type, &path, &PyList_Type, &py_list, &py_closed)) {
         return NULL;
     }
 
@@ -136,7 +184,9 @@ VGU_vguPolygon(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
         points[idx] = (VGfloat) PyFloat_AsDouble(element);
     }
 
+    VG_BEGIN_ALLOW_THREADS
     error = vguPolygon(path->obj, points, count/2, closed);
+    VG_END_ALLOW_THREADS
 
     free(points);
 
@@ -145,24 +195,41 @@ VGU_vguPolygon(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
         return NULL;
     }
 
+    path_record_segments(path, polygon_segments, 1);
+    for (idx = 1; idx < count/2; idx++) {
+        path_record_segments(path, polygon_segments + 1, 1);
+    }
+    if (closed)
+        path_record_segments(path, polygon_segments + 2, 1);
+    path_verify_segments(path);
+
     Py_RETURN_NONE;
 }
 
+static const char *const VGU_vguRoundRect_keywords[] = {"path", "x", "y", "width", "height", "arcWidth", "arcHeight", NULL};
+static const struct fast_parser VGU_vguRoundRect_parser = {"round_rect", VGU_vguRoundRect_keywords, 7, 7};
+
 static PyObject *
-VGU_vguRoundRect(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+VGU_vguRoundRect(PyObject * UNUSED(dummy), FAST_ARGS)
 {
+    PyObject *argv[7];
     VGUErrorCode error;
     PyVGPath *path;
     VGfloat x, y, width, height;
     VGfloat arcWidth, arcHeight;
 
-    const char *keywords[] = {"path", "x", "y", "width", "height",
-                              "arcWidth", "arcHeight", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!ffffff", (char **) keywords, &PyVGPath_Type, &path, &x, &y, &width, &height, &arcWidth, &arcHeight)) {
+    if (!fast_unpack(FAST_PASS, &VGU_vguRoundRect_parser, argv) ||
+        !fast_object(argv[0], &PyVGPath_Type, &path) ||
+        !fast_float(argv[1], &x) ||
+        !fast_float(argv[2], &y) ||
+        !fast_float(argv[3], &width) ||
+        !fast_float(argv[4], &height) ||
+        !fast_float(argv[5], &arcWidth) ||
+        !fast_float(argv[6], &arcHeight)) {
         return NULL;
     }
 
+    backend_wait();
     error = vguRoundRect(path->obj, x, y, width, height, arcWidth, arcHeight);
 
     if (error) {
@@ -170,21 +237,33 @@ VGU_vguRoundRect(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
         return NULL;
     }
 
+    path_record_segments(path, round_rect_segments, sizeof(round_rect_segments));
+    path_verify_segments(path);
+
     Py_RETURN_NONE;
 }
 
+static const char *const VGU_vguEllipse_keywords[] = {"path", "cx", "cy", "width", "height", NULL};
+static const struct fast_parser VGU_vguEllipse_parser = {"ellipse", VGU_vguEllipse_keywords, 5, 5};
+
 static PyObject *
-VGU_vguEllipse(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+VGU_vguEllipse(PyObject * UNUSED(dummy), FAST_ARGS)
 {
+    PyObject *argv[5];
     VGUErrorCode error;
     PyVGPath *path;
     VGfloat cx, cy, width, height;
-    const char *keywords[] = {"path", "cx", "cy", "width", "height", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!ffff", (char **) keywords, &PyVGPath_Type, &path, &cx, &cy, &width, &height)) {
+    if (!fast_unpack(FAST_PASS, &VGU_vguEllipse_parser, argv) ||
+        !fast_object(argv[0], &PyVGPath_Type, &path) ||
+        !fast_float(argv[1], &cx) ||
+        !fast_float(argv[2], &cy) ||
+        !fast_float(argv[3], &width) ||
+        !fast_float(argv[4], &height)) {
         return NULL;
     }
 
+    backend_wait();
     error = vguEllipse(path->obj, cx, cy, width, height);
 
     if (error) {
@@ -192,22 +271,33 @@ VGU_vguEllipse(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
         return NULL;
     }
 
+    path_record_segments(path, ellipse_segments, sizeof(ellipse_segments));
+    path_verify_segments(path);
+
     Py_RETURN_NONE;
 }
 
+static const char *const VGU_vguRect_keywords[] = {"path", "x", "y", "width", "height", NULL};
+static const struct fast_parser VGU_vguRect_parser = {"rect", VGU_vguRect_keywords, 5, 5};
+
 static PyObject *
-VGU_vguRect(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
+VGU_vguRect(PyObject * UNUSED(dummy), FAST_ARGS)
 {
+    PyObject *argv[5];
     VGUErrorCode error;
     PyVGPath *path;
     VGfloat x, y, width, height;
 
-    const char *keywords[] = {"path", "x", "y", "width", "height", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, (char *) "O!ffff", (char **) keywords, &PyVGPath_Type, &path, &x, &y, &width, &height)) {
+    if (!fast_unpack(FAST_PASS, &VGU_vguRect_parser, argv) ||
+        !fast_object(argv[0], &PyVGPath_Type, &path) ||
+        !fast_float(argv[1], &x) ||
+        !fast_float(argv[2], &y) ||
+        !fast_float(argv[3], &width) ||
+        !fast_float(argv[4], &height)) {
         return NULL;
     }
 
+    backend_wait();
     error = vguRect(path->obj, x, y, width, height);
 
     if (error) {
@@ -215,6 +305,9 @@ VGU_vguRect(PyObject * UNUSED(dummy), PyObject *args, PyObject *kwargs)
         return NULL;
     }
 
+    path_record_segments(path, rect_segments, sizeof(rect_segments));
+    path_verify_segments(path);
+
     Py_RETURN_NONE;
 }
 
@@ -247,7 +340,7 @@ VGU_vguComputeWarpQuadToSquare(PyObject * UNUSED(dummy), PyObject *args, PyObjec
         PyList_SET_ITEM(py_list, idx, PyFloat_FromDouble(matrix[idx]));
     }
 
-    return Py_BuildValue((char *) "N", py_list);
+    return py_list;
 
 }
 
@@ -283,7 +376,7 @@ VGU_vguComputeWarpQuadToQuad(PyObject * UNUSED(dummy), PyObject *args, PyObject
         PyList_SET_ITEM(py_list, idx, PyFloat_FromDouble(matrix[idx]));
     }
 
-    return Py_BuildValue((char *) "N", py_list);
+    return py_list;
 }
 
 static PyObject *
@@ -315,24 +408,24 @@ VGU_vguComputeWarpSquareToQuad(PyObject * UNUSED(dummy), PyObject *args, PyObjec
         PyList_SET_ITEM(py_list, idx, PyFloat_FromDouble(matrix[idx]));
     }
 
-    return Py_BuildValue((char *) "N", py_list);
+    return py_list;
 }
 
 
 static PyMethodDef VGU_functions[] = {
     {(char *) "arc",
      (PyCFunction) VGU_vguArc,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      NULL
     },
     {(char *) "line",
      (PyCFunction) VGU_vguLine,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      NULL
     },
     {(char *) "ellipse",
      (PyCFunction) VGU_vguEllipse,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      NULL
     },
     {(char *) "polygon",
@@ -342,12 +435,12 @@ static PyMethodDef VGU_functions[] = {
     },
     {(char *) "rect",
      (PyCFunction) VGU_vguRect,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      NULL
     },
     {(char *) "round_rect",
      (PyCFunction) VGU_vguRoundRect,
-     METH_KEYWORDS|METH_VARARGS,
+     METH_FAST,
      NULL
     },
     {(char *) "compute_warp_square_to_quad",